@@ -0,0 +1,49 @@
+#ifndef ALLOCATIONBENCHMARK_HPP
+#define ALLOCATIONBENCHMARK_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Structure to hold one solver run on one kind of input allocation.
+ *
+ * run() returns the median run of each (allocation, solver) pair.
+ */
+struct AllocationResult {
+    std::string allocation;  // e.g. "std::vector", "THP buffer"
+    std::string solver;      // "Dynamic" or "Greedy"
+    double time;             // in milliseconds
+    double elementsPerSec;
+    long long dtlbMisses;    // -1 if the counter is unavailable
+    long long result;
+};
+
+/**
+ * @brief Compares std::vector<int> input against huge-page HeightBuffers.
+ *
+ * Generates one synthetic height profile, places it in a plain vector, a
+ * transparent huge page buffer and an explicit huge page buffer, and runs
+ * the Dynamic and Greedy solutions on each. Both solvers are single-threaded,
+ * so the buffers are first-touched by the calling thread, which is the one
+ * that solves; touching from more threads would only spread the pages over
+ * NUMA nodes the solver then reads remotely. The naive solution is skipped
+ * since it is quadratic.
+ *
+ * Every row gets a warm-up call and then several timed calls, interleaved
+ * across rows, and reports its median. Dynamic reuses one preallocated
+ * DynamicScratch, so its rows time the solve rather than the allocation
+ * of its max arrays.
+ */
+class AllocationBenchmark {
+public:
+    /**
+     * @brief Runs the benchmark and prints a comparison table.
+     *
+     * @param size Number of heights in the generated profile.
+     * @return One AllocationResult per (allocation, solver) pair.
+     */
+    std::vector<AllocationResult> run(std::size_t size);
+};
+
+#endif // ALLOCATIONBENCHMARK_HPP
@@ -12,6 +12,9 @@
  *   - The first line is a comma-separated list representing the input array.
  *   - The second line is a single value representing the expected output.
  *
+ * The file may be gzip- or zstd-compressed; it is decompressed on the fly
+ * by a StreamingLineReader.
+ *
  * After running the tests, the class stores the elapsed time (in milliseconds)
  * for each test case. Use getElapsedTimes() to retrieve the time vector.
  */
@@ -26,7 +29,7 @@ public:
      *
      * @param filename The path to the CSV file containing the test cases.
      * @param customFunction A function that takes a const std::vector<int>& and returns an int.
-     * @return true if all test cases pass; false otherwise.
+     * @return true if the whole file was read and all test cases pass; false otherwise.
      */
     bool runTests(const std::string& filename,
                   const std::function<int(const std::vector<int>&)>& customFunction);
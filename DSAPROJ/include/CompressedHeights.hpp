@@ -0,0 +1,121 @@
+#ifndef COMPRESSEDHEIGHTS_HPP
+#define COMPRESSEDHEIGHTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Summary stored for every block of a CompressedHeights profile.
+ *
+ * The max and sum let a solver handle a block without decoding it whenever
+ * the running maximum already covers the whole block.
+ */
+struct BlockHeader {
+    std::int32_t first;    // first height of the block (the delta base)
+    std::int32_t max;      // largest height in the block
+    std::int64_t sum;      // sum of all heights in the block
+    std::uint32_t offset;  // bit offset of the packed deltas in the block's word run
+    std::uint32_t word;    // index of the first packed word used by the block
+    std::uint8_t width;    // bits per zigzag-encoded delta (0..32)
+};
+
+/**
+ * @brief A height profile stored as block-wise, bit-packed deltas.
+ *
+ * Heights are split into blocks of kBlockSize. Within a block the first
+ * height is kept verbatim in the header and every following height is
+ * stored as the zigzag-encoded difference from its predecessor, packed with
+ * the smallest bit width that fits the block. Profiles whose neighbours
+ * differ by small amounts shrink to a few bits per element.
+ *
+ * The same layout is written to disk by save() and read back by load().
+ */
+class CompressedHeights {
+public:
+    /**
+     * @brief Number of heights per block (the last block may be shorter).
+     */
+    static const std::size_t kBlockSize = 256;
+
+    CompressedHeights();
+
+    /**
+     * @brief Compresses a raw array of heights.
+     */
+    static CompressedHeights encode(const int* heights, std::size_t size);
+
+    /**
+     * @brief Compresses a vector of heights.
+     */
+    static CompressedHeights encode(const std::vector<int>& heights);
+
+    /**
+     * @brief Returns the number of heights in the profile.
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Returns the number of blocks.
+     */
+    std::size_t blockCount() const { return headers_.size(); }
+
+    /**
+     * @brief Returns the header of block @p b.
+     */
+    const BlockHeader& header(std::size_t b) const { return headers_[b]; }
+
+    /**
+     * @brief Returns the number of heights in block @p b.
+     */
+    std::size_t blockLength(std::size_t b) const;
+
+    /**
+     * @brief Decodes block @p b into @p out, which must hold kBlockSize ints.
+     */
+    void decodeBlock(std::size_t b, int* out) const;
+
+    /**
+     * @brief Returns the bytes of packed words decodeBlock(b) reads.
+     */
+    std::size_t blockPayloadBytes(std::size_t b) const;
+
+    /**
+     * @brief Decodes the whole profile.
+     */
+    std::vector<int> decode() const;
+
+    /**
+     * @brief Returns the in-memory (and on-disk payload) size in bytes.
+     */
+    std::size_t compressedBytes() const;
+
+    /**
+     * @brief Returns raw int bytes divided by compressedBytes().
+     */
+    double compressionRatio() const;
+
+    /**
+     * @brief Writes the profile to a binary file.
+     *
+     * @return true if the file was written; false otherwise.
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Reads a profile written by save().
+     *
+     * @param filename The path to the binary file.
+     * @param out Receives the profile on success.
+     * @return true if the file was read; false if it is missing or malformed.
+     */
+    static bool load(const std::string& filename, CompressedHeights& out);
+
+private:
+    std::size_t size_;
+    std::vector<BlockHeader> headers_;
+    std::vector<std::uint64_t> words_;
+};
+
+#endif // COMPRESSEDHEIGHTS_HPP
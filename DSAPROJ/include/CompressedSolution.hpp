@@ -0,0 +1,34 @@
+#ifndef COMPRESSEDSOLUTION_HPP
+#define COMPRESSEDSOLUTION_HPP
+
+#include <cstddef>
+#include "CompressedHeights.hpp"
+
+/**
+ * @brief Computes trapped water directly on a CompressedHeights profile.
+ *
+ * The block headers locate a global maximum without decoding anything. Left
+ * of it the water at each height is the running left maximum minus the
+ * height, right of it the running right maximum minus the height. A block
+ * whose max does not exceed the running maximum therefore contributes
+ * runningMax * length - sum, taken straight from its header; only blocks
+ * that raise the running maximum are decoded, one block at a time into a
+ * small stack buffer.
+ */
+class CompressedSolution {
+public:
+    /**
+     * @brief Returns the water trapped by the compressed profile.
+     *
+     * @param heights The compressed profile.
+     * @param blocksDecoded If non-null, receives the number of blocks that
+     *        had to be decoded (the rest were answered from their headers).
+     * @param bytesRead If non-null, receives the bytes actually read: every
+     *        block header plus the packed words of the decoded blocks.
+     * @return The trapped water, accumulated in 64 bits.
+     */
+    long long findWater(const CompressedHeights& heights, std::size_t* blocksDecoded = nullptr,
+                        std::size_t* bytesRead = nullptr) const;
+};
+
+#endif // COMPRESSEDSOLUTION_HPP
@@ -0,0 +1,27 @@
+#ifndef COMPRESSIONBENCHMARK_HPP
+#define COMPRESSIONBENCHMARK_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Compares solving on CompressedHeights against raw int arrays.
+ *
+ * Generates a random-walk profile, compresses it, round-trips it through
+ * a file on disk, and prints the compression ratio together with the solve
+ * throughput of CompressedSolution, DynamicSolution and GreedySolution.
+ * Each solver gets a warm-up call and reports the median of several timed
+ * calls; DynamicSolution reuses preallocated scratch.
+ */
+class CompressionBenchmark {
+public:
+    /**
+     * @brief Runs the benchmark and prints the results.
+     *
+     * @param size Number of heights in the generated profile.
+     * @param maxStep Largest difference between neighbouring heights.
+     * @return true if every solver agreed on the result; false otherwise.
+     */
+    bool run(std::size_t size, int maxStep);
+};
+
+#endif // COMPRESSIONBENCHMARK_HPP
@@ -0,0 +1,143 @@
+#ifndef CYCLETIMER_HPP
+#define CYCLETIMER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLETIMER_HAS_TSC 1
+#endif
+
+/**
+ * @brief Low-overhead timer for kernels that run in well under a microsecond.
+ *
+ * On x86 CPUs with an invariant TSC the timer reads the time-stamp counter
+ * with serializing fences (lfence/rdtsc at the start, rdtscp/lfence at the
+ * end), calibrates its frequency against std::chrono::steady_clock and
+ * measures its own back-to-back read cost so that cost can be subtracted.
+ * Elsewhere it falls back to steady_clock with ticks in nanoseconds.
+ *
+ * Tiny kernels should be timed in batches: batchSizeFor() estimates a batch
+ * long enough that the read overhead is negligible, and calibrateBatch()
+ * confirms it on warm calls.
+ */
+class CycleTimer {
+public:
+    /**
+     * @brief Returns the process-wide timer, calibrating it on first use.
+     */
+    static const CycleTimer& instance();
+
+    /**
+     * @brief Returns true if ticks are TSC cycles; false for steady_clock ns.
+     */
+    bool usesTsc() const { return usesTsc_; }
+
+    /**
+     * @brief Returns the number of ticks per nanosecond.
+     */
+    double ticksPerNs() const { return ticksPerNs_; }
+
+    /**
+     * @brief Returns the cost of a start()/stop() pair, in ticks.
+     */
+    double overheadTicks() const { return overheadTicks_; }
+
+    /**
+     * @brief Reads the clock at the start of a measured region.
+     */
+    std::uint64_t start() const {
+#ifdef CYCLETIMER_HAS_TSC
+        if (usesTsc_) {
+            _mm_lfence();
+            std::uint64_t t = __rdtsc();
+            _mm_lfence();
+            return t;
+        }
+#endif
+        return steadyNow();
+    }
+
+    /**
+     * @brief Reads the clock at the end of a measured region.
+     */
+    std::uint64_t stop() const {
+#ifdef CYCLETIMER_HAS_TSC
+        if (usesTsc_) {
+            unsigned aux;
+            std::uint64_t t = __rdtscp(&aux);
+            _mm_lfence();
+            return t;
+        }
+#endif
+        return steadyNow();
+    }
+
+    /**
+     * @brief Converts an elapsed tick count to ticks with the overhead removed.
+     */
+    double netTicks(std::uint64_t startTicks, std::uint64_t stopTicks) const;
+
+    /**
+     * @brief Converts ticks to nanoseconds.
+     */
+    double toNs(double ticks) const { return ticks / ticksPerNs_; }
+
+    /**
+     * @brief Estimates how many calls to time between two clock reads.
+     *
+     * Only a starting point: a cold call can be many times slower than a
+     * warm one, so pass the result to calibrateBatch() before timing.
+     *
+     * @param elements Input length of one call; used to estimate the call
+     *        cost when no measurement is available yet.
+     * @param callTicks Measured cost of one call in ticks, or 0 if unknown.
+     * @return A batch size in [1, kMaxBatch].
+     */
+    std::size_t batchSizeFor(std::size_t elements, double callTicks = 0.0) const;
+
+    /**
+     * @brief Returns the shortest a timed batch should be, in ticks: at
+     * least 20 us and 1000x the start()/stop() overhead.
+     */
+    double batchTargetTicks() const;
+
+    /**
+     * @brief Doubles @p batch until one timed batch of warm calls reaches
+     * batchTargetTicks() (or the batch reaches kMaxBatch).
+     *
+     * @param call Invoked batch times per attempt; should already be warm.
+     * @param batch Starting batch size, e.g. from batchSizeFor().
+     * @return The calibrated batch size.
+     */
+    template <typename Fn>
+    std::size_t calibrateBatch(const Fn& call, std::size_t batch) const {
+        if (batch < 1)
+            batch = 1;
+        while (true) {
+            std::uint64_t startTicks = start();
+            for (std::size_t i = 0; i < batch; i++)
+                call();
+            std::uint64_t stopTicks = stop();
+            if (netTicks(startTicks, stopTicks) >= batchTargetTicks() || batch >= kMaxBatch)
+                return batch;
+            batch = (batch * 2 > kMaxBatch) ? kMaxBatch : batch * 2;
+        }
+    }
+
+    /**
+     * @brief Upper bound on the batch size returned by batchSizeFor().
+     */
+    static const std::size_t kMaxBatch = 1 << 20;
+
+private:
+    CycleTimer();
+    static std::uint64_t steadyNow();
+
+    bool usesTsc_;
+    double ticksPerNs_;
+    double overheadTicks_;
+};
+
+#endif // CYCLETIMER_HPP
@@ -1,6 +1,24 @@
 #include <vector>
 #include "Solution.hpp"
+
+/**
+ * @brief Left/right running-max arrays reused across DynamicSolution calls.
+ *
+ * Grown on demand and kept between calls, so a long-running caller (such as
+ * a SolverServer worker) does not map, zero and unmap them per request.
+ */
+struct DynamicScratch {
+    HeightBuffer leftMax;
+    HeightBuffer rightMax;
+};
+
 class DynamicSolution : public Solution {
     public:
+using Solution::findWater;
 int findWater(const std::vector<int>& vec) const override;
+long long findWater(const int* vec, std::size_t n) const override;
+/**
+ * @brief Same as findWater(vec, n), but keeps its max arrays in @p scratch.
+ */
+long long findWater(const int* vec, std::size_t n, DynamicScratch& scratch) const;
    };
\ No newline at end of file
@@ -2,5 +2,7 @@
 #include "Solution.hpp"
 class GreedySolution : public Solution {
     public:
+using Solution::findWater;
 int findWater(const std::vector<int>& vec) const override;
+long long findWater(const int* vec, std::size_t n) const override;
    };
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef HEIGHTBUFFER_HPP
+#define HEIGHTBUFFER_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief How a HeightBuffer asks the kernel to back its memory.
+ */
+enum class HugePageMode {
+    None,         // regular 4 KiB pages
+    Transparent,  // 2 MiB-aligned mapping advised with MADV_HUGEPAGE
+    Explicit      // MAP_HUGETLB from the reserved pool, falling back to Transparent
+};
+
+/**
+ * @brief A 2 MiB-aligned array of heights for very large inputs.
+ *
+ * The buffer is mapped directly with mmap so it can be backed by huge pages,
+ * which cuts dTLB misses when a solver streams over 10^8+ elements. Pages are
+ * not touched on allocation: the constructor (or fromVector) splits the array
+ * into page-aligned chunks and has one thread first-touch each chunk, so on a
+ * NUMA machine each chunk lands on the node of the thread that wrote it.
+ * Chunk 0 is touched by the calling thread.
+ *
+ * Placement only helps if the same threads later process the same chunks
+ * (see chunkBegin()). The solvers are single-threaded, so buffers they read
+ * should keep the default of one touch thread: the caller, which is then
+ * also the thread that solves. Spreading the touch over more threads than
+ * will read the buffer scatters its pages across nodes instead.
+ */
+class HeightBuffer {
+public:
+    /**
+     * @brief Alignment (and huge page size) of every buffer, in bytes.
+     */
+    static const std::size_t kAlignment = 2 * 1024 * 1024;
+
+    /**
+     * @brief Constructs an empty buffer.
+     */
+    HeightBuffer();
+
+    /**
+     * @brief Allocates a zero-filled buffer.
+     *
+     * @param size Number of elements.
+     * @param mode Huge page policy for the mapping.
+     * @param touchThreads Number of threads that first-touch the chunks; match
+     *        the number of threads that will process the buffer.
+     * @throws std::bad_alloc if the mapping cannot be created.
+     */
+    explicit HeightBuffer(std::size_t size,
+                          HugePageMode mode = HugePageMode::Transparent,
+                          unsigned touchThreads = 1);
+
+    /**
+     * @brief Allocates a buffer and copies heights into it, chunk by chunk.
+     *
+     * The copy itself is the first touch, so each chunk is placed on the node
+     * of the thread that copied it.
+     */
+    static HeightBuffer fromVector(const std::vector<int>& heights,
+                                   HugePageMode mode = HugePageMode::Transparent,
+                                   unsigned touchThreads = 1);
+
+    ~HeightBuffer();
+    HeightBuffer(HeightBuffer&& other) noexcept;
+    HeightBuffer& operator=(HeightBuffer&& other) noexcept;
+    HeightBuffer(const HeightBuffer&) = delete;
+    HeightBuffer& operator=(const HeightBuffer&) = delete;
+
+    int* data() { return data_; }
+    const int* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    int& operator[](std::size_t i) { return data_[i]; }
+    const int& operator[](std::size_t i) const { return data_[i]; }
+    int* begin() { return data_; }
+    int* end() { return data_ + size_; }
+    const int* begin() const { return data_; }
+    const int* end() const { return data_ + size_; }
+
+    /**
+     * @brief Returns true if the mapping came from the explicit huge page pool.
+     */
+    bool usesExplicitHugePages() const { return explicitHuge_; }
+
+    /**
+     * @brief Returns the first element of chunk @p index when @p size elements
+     * are split across @p chunks threads on huge page boundaries.
+     *
+     * Chunk i covers [chunkBegin(size, i, chunks), chunkBegin(size, i + 1, chunks)).
+     */
+    static std::size_t chunkBegin(std::size_t size, unsigned index, unsigned chunks);
+
+private:
+    void allocate(std::size_t size, HugePageMode mode);
+    void release();
+
+    int* data_;
+    std::size_t size_;
+    void* mapping_;
+    std::size_t mappingBytes_;
+    bool explicitHuge_;
+};
+
+#endif // HEIGHTBUFFER_HPP
@@ -0,0 +1,42 @@
+#ifndef LATENCYSTATS_HPP
+#define LATENCYSTATS_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Thread-safe collector of latency samples with percentile queries.
+ *
+ * Keeps the most recent kCapacity samples in a ring so a long-running
+ * server uses bounded memory; the total count keeps growing.
+ */
+class LatencyStats {
+public:
+    static const std::size_t kCapacity = 1 << 20;
+
+    /**
+     * @brief Records one latency sample, in microseconds.
+     */
+    void record(double micros);
+
+    /**
+     * @brief Returns the number of samples recorded since construction.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief Returns the given percentiles (each in [0, 100]) of the kept samples.
+     *
+     * @return One value per requested percentile; all 0 if there are no samples.
+     */
+    std::vector<double> percentiles(const std::vector<double>& ps) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<double> samples_;
+    std::size_t next_ = 0;
+    std::size_t total_ = 0;
+};
+
+#endif // LATENCYSTATS_HPP
@@ -0,0 +1,60 @@
+#ifndef MACHINEPROBE_HPP
+#define MACHINEPROBE_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Single-core read bandwidth of one level of the memory hierarchy.
+ */
+struct BandwidthCeiling {
+    const char* level;          // "L1", "L2", "L3" or "DRAM"
+    std::size_t capacityBytes;  // largest working set served from this level
+    double bytesPerSec;         // sustained read bandwidth from one thread
+};
+
+/**
+ * @brief Measured hardware ceilings used to put solver timings in context.
+ */
+struct MachineCeilings {
+    std::vector<BandwidthCeiling> bandwidth;  // innermost level first, DRAM last
+    double allCoreBytesPerSec;     // DRAM read bandwidth with every hardware thread scanning
+    unsigned threads;              // threads used for allCoreBytesPerSec
+    double scalarElementsPerSec;   // scalar element loads+adds per second, one core, L1-resident
+
+    /**
+     * @brief Returns the innermost level whose capacity holds @p workingSetBytes.
+     */
+    const BandwidthCeiling& bandwidthFor(std::size_t workingSetBytes) const;
+};
+
+/**
+ * @brief Measures the machine's memory and scalar throughput ceilings.
+ *
+ * Read bandwidth is measured per cache level by repeatedly scanning a
+ * buffer half the size of that level (sizes from sysconf, with common
+ * defaults where the C library does not report them), and for DRAM by
+ * scanning a buffer well beyond the last-level cache. The scans use
+ * std::memchr (libc's vectorized scan, so the figures reflect the memory
+ * system rather than this build's optimization flags) from one thread,
+ * matching the single-threaded solvers. The all-core DRAM figure has one
+ * thread per hardware thread scan its own slice of the DRAM buffer at
+ * once; the gap between it and a solver's rate is the headroom a parallel
+ * solver could claim. Scalar throughput is the rate at which an unrolled
+ * load-and-add loop over a cache-resident array touches elements, compiled
+ * with the same flags as the solvers.
+ */
+class MachineProbe {
+public:
+    /**
+     * @brief Returns the ceilings, measuring them on the first call only.
+     *
+     * The first call takes roughly half a second.
+     */
+    static const MachineCeilings& ceilings();
+
+private:
+    static MachineCeilings measure();
+};
+
+#endif // MACHINEPROBE_HPP
@@ -19,6 +19,14 @@ private:
     void runGreedyTests();
     // Function to run all tests and compare the results.
     void runAllTestsAndCompare();
+    // Function to compare vector and huge-page input allocation.
+    void runAllocationBenchmark();
+    // Function to compare compressed and raw height solving.
+    void runCompressionBenchmark();
+    // Function to benchmark the sliding-window water monitor.
+    void runSlidingWindowBenchmark();
+    // Function to measure how fast the test file is read and parsed.
+    void runInputThroughput();
 };
 
 #endif // MENU_HPP
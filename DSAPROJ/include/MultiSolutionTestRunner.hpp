@@ -30,6 +30,9 @@ struct TestResult {
  *   - The first line is a comma-separated list representing an array.
  *   - The second line is the expected output.
  *
+ * The file may be gzip- or zstd-compressed; it is decompressed on the fly
+ * by a StreamingLineReader.
+ *
  * This class will run three solution functions (naive, dynamic, greedy) on each test case,
  * record the results, elapsed times, and pass/fail status, print a summary, and provide
  * getter functions for the elapsed time vectors.
@@ -62,6 +65,19 @@ public:
                                            const std::function<int(const std::vector<int>&)>& solutionFunc,
                                            const std::string& label);
     
+    /**
+     * @brief Reads and parses every test case without running any solution.
+     *
+     * Prints the effective input rate in MB/s, both for the bytes read from
+     * disk and for the (decompressed) text, so gzip/zstd corpora can be
+     * compared against plain CSV.
+     *
+     * @param filename The CSV file, optionally gzip- or zstd-compressed.
+     * @return true if the whole file was read; false if it could not be
+     *         opened or ended on a read or decompression error.
+     */
+    bool measureInputThroughput(const std::string& filename);
+    
     /**
      * @brief Returns the vector of elapsed times (in ms) for the naive solution.
      */
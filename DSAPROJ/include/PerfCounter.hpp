@@ -0,0 +1,42 @@
+#ifndef PERFCOUNTER_HPP
+#define PERFCOUNTER_HPP
+
+/**
+ * @brief A single Linux hardware performance counter for the calling thread.
+ *
+ * Wraps perf_event_open. If the kernel or container does not allow the
+ * counter (see /proc/sys/kernel/perf_event_paranoid) available() returns
+ * false and stop() returns -1, so callers can print "n/a" instead.
+ */
+class PerfCounter {
+public:
+    /**
+     * @brief Counter for data-TLB read misses in user space.
+     */
+    static PerfCounter dtlbReadMisses();
+
+    ~PerfCounter();
+    PerfCounter(PerfCounter&& other) noexcept;
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+    PerfCounter& operator=(PerfCounter&&) = delete;
+
+    bool available() const { return fd_ >= 0; }
+
+    /**
+     * @brief Resets the counter to zero and starts counting.
+     */
+    void start();
+
+    /**
+     * @brief Stops counting and returns the count, or -1 if unavailable.
+     */
+    long long stop();
+
+private:
+    PerfCounter(unsigned type, unsigned long long config);
+
+    int fd_;
+};
+
+#endif // PERFCOUNTER_HPP
@@ -0,0 +1,20 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Builds a reproducible random-walk height profile for benchmarks.
+ *
+ * Each height differs from the previous one by at most maxStep and is
+ * clamped to [0, 1000], which mimics terrain-like inputs where neighbours
+ * are close.
+ *
+ * @param size Number of heights.
+ * @param maxStep Largest absolute difference between neighbours.
+ * @param seed Seed for the random generator.
+ */
+std::vector<int> makeRandomWalkProfile(std::size_t size, int maxStep = 8, unsigned seed = 12345);
+
+#endif // PROFILE_HPP
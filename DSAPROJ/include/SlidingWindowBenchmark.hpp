@@ -0,0 +1,22 @@
+#ifndef SLIDINGWINDOWBENCHMARK_HPP
+#define SLIDINGWINDOWBENCHMARK_HPP
+
+/**
+ * @brief Measures SlidingWindowWater throughput across window sizes.
+ *
+ * For windows of 10^2 to 10^7 samples, streams a random-walk profile
+ * through a SlidingWindowWater, querying the water after every sample, and
+ * prints samples per second next to the rate of re-running GreedySolution
+ * on each window. Small windows are also cross-checked against it.
+ */
+class SlidingWindowBenchmark {
+public:
+    /**
+     * @brief Runs the benchmark and prints the results.
+     *
+     * @return true if the monitor agreed with GreedySolution on every check.
+     */
+    bool run();
+};
+
+#endif // SLIDINGWINDOWBENCHMARK_HPP
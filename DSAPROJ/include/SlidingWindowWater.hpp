@@ -0,0 +1,92 @@
+#ifndef SLIDINGWINDOWWATER_HPP
+#define SLIDINGWINDOWWATER_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Tracks the water trapped by the most recent W samples of a stream.
+ *
+ * The window is kept as a two-stack queue: new samples are appended to a
+ * back segment and old samples are dropped from the front of a front
+ * segment; when the front runs dry the back segment is moved over in one
+ * O(W) rebuild, so each sample is moved at most once.
+ *
+ * Water over the window splits at the position M of the last maximum:
+ * left of M each height holds (prefix max - height), right of M
+ * (suffix max - height). Each segment keeps exactly the bookkeeping that
+ * makes those sums cheap to combine:
+ *  - back: its prefix-max staircase (with running sums) and a monotonic
+ *    stack of its suffix maxima with their running sum,
+ *  - front: for every start index, the prefix-max sum up to the end of the
+ *    segment, the position of its last maximum, and its suffix maxima with
+ *    prefix sums.
+ * push() is amortized O(1) and water() is O(log W).
+ */
+class SlidingWindowWater {
+public:
+    /**
+     * @brief Creates a monitor over the most recent @p window samples.
+     *
+     * @param window Window length; must be at least 1.
+     */
+    explicit SlidingWindowWater(std::size_t window);
+
+    /**
+     * @brief Appends a sample, evicting the oldest one once the window is full.
+     */
+    void push(int height);
+
+    /**
+     * @brief Returns the water trapped by the samples currently in the window.
+     */
+    long long water() const;
+
+    /**
+     * @brief Returns the number of samples currently in the window.
+     */
+    std::size_t size() const { return (front_.size() - frontStart_) + back_.size(); }
+
+    /**
+     * @brief Returns the configured window length.
+     */
+    std::size_t window() const { return window_; }
+
+private:
+    // A run of equal suffix maxima in the back segment.
+    struct SuffixRun {
+        int value;
+        std::size_t count;
+    };
+
+    // A step of the back segment's prefix-max staircase.
+    struct Step {
+        int value;
+        std::size_t start;   // index in back_ where this maximum begins
+        long long before;    // sum of prefix maxima over back_[0, start)
+    };
+
+    void popFront();
+    void rebuildFront();
+    long long backPrefixSumClamped(long long floor) const;
+
+    std::size_t window_;
+
+    // Back segment: newest samples, in arrival order.
+    std::vector<int> back_;
+    std::vector<Step> steps_;
+    std::vector<SuffixRun> suffix_;  // bottom (index 0) is the segment maximum
+    long long suffixSum_;            // sum of suffix maxima over back_
+
+    // Front segment: oldest samples; live range is [frontStart_, front_.size()).
+    std::vector<int> front_;
+    std::vector<long long> prefixFrom_;  // sum of prefix maxima from i to the end
+    std::vector<std::size_t> lastMax_;   // last position of max(front_[i..end])
+    std::vector<int> frontSuffix_;       // max(front_[i..end]), non-increasing
+    std::vector<long long> frontSuffixSums_;  // sums of frontSuffix_ over [0, i)
+    std::size_t frontStart_;
+
+    long long heightSum_;  // sum of every height in the window
+};
+
+#endif // SLIDINGWINDOWWATER_HPP
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstddef>
 #include <vector>
+#include "HeightBuffer.hpp"
 
  class Solution {
   public:
@@ -27,5 +29,26 @@
     * to define a specific seasonal behavior.
     */
    virtual int findWater(const std::vector<int>& vec) const = 0;
+
+   /**
+    * @brief Computes the trapped water over a raw array of heights.
+    *
+    * @param heights Pointer to the first height.
+    * @param size Number of heights.
+    * @return The trapped water, accumulated in 64 bits.
+    *
+    * @details Lets callers pass storage other than std::vector<int>, such as
+    * a huge-page backed HeightBuffer. Arrays of 10^8+ heights easily trap
+    * more than INT_MAX units of water, so use this overload (not the
+    * std::vector one, which returns int) for large inputs.
+    */
+   virtual long long findWater(const int* heights, std::size_t size) const = 0;
+
+   /**
+    * @brief Computes the trapped water over a HeightBuffer.
+    */
+   long long findWater(const HeightBuffer& heights) const {
+     return findWater(heights.data(), heights.size());
+   }
  };
  
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef SOLVERPROTOCOL_HPP
+#define SOLVERPROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Wire format spoken by SolverServer over its Unix domain socket.
+ *
+ * All fields are in host byte order since client and server share a
+ * machine. A client may pipeline any number of requests on one connection;
+ * responses carry the request id and can arrive out of order because
+ * requests are solved in batches by several workers.
+ *
+ * Solve:  RequestHeader{type = kSolve, count = n} followed by n int32 heights,
+ *         answered by a SolveResponse.
+ * Stats:  RequestHeader{type = kStats, count = 0},
+ *         answered by a StatsResponse.
+ *
+ * A request with an unknown type, a kStats request with count != 0, or a
+ * solve request above the size limit for its solver has its payload
+ * skipped and is answered by a SolveResponse with status kBadRequest.
+ */
+namespace SolverProtocol {
+
+const std::uint32_t kMagic = 0x44535752;  // "DSWR"
+
+// Largest accepted request, in heights (64 MiB of payload).
+const std::uint32_t kMaxHeights = 1u << 24;
+
+// Largest accepted kNaive request: it is O(n^2), and a worker solving it
+// also holds up every request batched with it.
+const std::uint32_t kMaxNaiveHeights = 1u << 14;
+
+enum RequestType : std::uint32_t {
+    kSolve = 0,
+    kStats = 1
+};
+
+enum SolverId : std::uint32_t {
+    kNaive = 0,
+    kDynamic = 1,
+    kGreedy = 2
+};
+
+enum Status : std::uint32_t {
+    kOk = 0,
+    kBadSolver = 1,
+    kBadRequest = 2
+};
+
+struct RequestHeader {
+    std::uint32_t magic;
+    std::uint32_t type;    // RequestType
+    std::uint32_t solver;  // SolverId, ignored for kStats
+    std::uint32_t count;   // number of int32 heights that follow
+    std::uint64_t id;      // echoed back in the response
+};
+
+struct SolveResponse {
+    std::uint32_t magic;
+    std::uint32_t status;  // Status
+    std::uint64_t id;
+    std::int64_t water;
+};
+
+struct StatsResponse {
+    std::uint32_t magic;
+    std::uint32_t status;
+    std::uint64_t id;
+    std::uint64_t requests;      // solve requests answered since start
+    std::uint64_t batches;       // worker batches those requests were grouped into
+    double uptimeSec;
+    double requestsPerSec;
+    double p50Us;                // server-side latency percentiles, in microseconds
+    double p90Us;
+    double p99Us;
+    double p999Us;
+};
+
+/**
+ * @brief Reads exactly @p size bytes, retrying on short reads and EINTR.
+ *
+ * @return true on success; false on EOF or error.
+ */
+bool readFully(int fd, void* buffer, std::size_t size);
+
+/**
+ * @brief Writes exactly @p size bytes, retrying on short writes and EINTR.
+ *
+ * @return true on success; false on error.
+ */
+bool writeFully(int fd, const void* buffer, std::size_t size);
+
+} // namespace SolverProtocol
+
+#endif // SOLVERPROTOCOL_HPP
@@ -0,0 +1,113 @@
+#ifndef SOLVERSERVER_HPP
+#define SOLVERSERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LatencyStats.hpp"
+
+/**
+ * @brief Long-running solver daemon listening on a Unix domain socket.
+ *
+ * Avoids paying process start-up, menu and CSV parsing costs per call:
+ * clients send binary requests (see SolverProtocol.hpp) and get the
+ * trapped water back. One reader thread per connection decodes requests
+ * into a shared queue; a fixed pool of worker threads drains that queue in
+ * batches of up to maxBatch requests, so bursts of small concurrent
+ * requests are coalesced into one wake-up, while a backlog is split across
+ * the workers rather than taken by the first one awake. The queue is
+ * bounded in requests and heights: a reader that would overflow it waits
+ * for the workers to catch up and stops reading its socket meanwhile, so a
+ * pipelining client is slowed down instead of growing the server's memory
+ * without limit. Height buffers are recycled
+ * through a pool so their capacity stays allocated between requests, and
+ * each worker keeps its own solver instances and DynamicSolution scratch
+ * arrays. Payloads are read in bounded chunks, and requests above the
+ * protocol's size limits are rejected with kBadRequest.
+ *
+ * Server-side latency (request decoded to response written) and
+ * throughput are exposed through the kStats request and printed on exit.
+ */
+class SolverServer {
+public:
+    /**
+     * @param socketPath Filesystem path of the socket; replaced if it exists.
+     * @param workers Number of solver threads (at least 1).
+     * @param maxBatch Most requests a worker takes from the queue at once.
+     */
+    SolverServer(const std::string& socketPath, unsigned workers, std::size_t maxBatch);
+    ~SolverServer();
+
+    SolverServer(const SolverServer&) = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+
+    /**
+     * @brief Accepts and serves connections until stop() is called.
+     *
+     * @return false if the socket could not be set up; true after a clean stop.
+     */
+    bool run();
+
+    /**
+     * @brief Asks run() to return. Safe to call from a signal handler.
+     */
+    void stop();
+
+    /**
+     * @brief Prints request count, requests/second and latency percentiles.
+     */
+    void printStats() const;
+
+private:
+    struct Connection;
+    struct Request;
+
+    // A connection's reader thread; done is set when the thread is about to exit.
+    struct Reader {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+
+    void readLoop(std::shared_ptr<Connection> connection, std::shared_ptr<std::atomic<bool>> done);
+    void reapReaders();
+    void workerLoop();
+    void answerStats(const std::shared_ptr<Connection>& connection, std::uint64_t id);
+    void answerError(const std::shared_ptr<Connection>& connection, std::uint64_t id,
+                     std::uint32_t status);
+    std::vector<int> takeBuffer();
+    void returnBuffer(std::vector<int>&& buffer);
+
+    std::string socketPath_;
+    unsigned workerCount_;
+    std::size_t maxBatch_;
+    std::atomic<bool> stopping_;
+    int listenFd_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueReady_;   // signalled when requests are queued
+    std::condition_variable queueSpace_;   // signalled when workers take requests
+    std::deque<std::unique_ptr<Request>> queue_;
+    std::size_t queuedHeights_;            // heights held by requests in queue_
+
+    std::mutex poolMutex_;
+    std::vector<std::vector<int>> bufferPool_;
+
+    std::mutex connectionsMutex_;
+    std::vector<std::weak_ptr<Connection>> connections_;
+    std::vector<Reader> readers_;
+    std::vector<std::thread> workers_;
+
+    LatencyStats latency_;
+    std::atomic<std::uint64_t> batches_;
+};
+
+#endif // SOLVERSERVER_HPP
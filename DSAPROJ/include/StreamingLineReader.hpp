@@ -0,0 +1,153 @@
+#ifndef STREAMINGLINEREADER_HPP
+#define STREAMINGLINEREADER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Line reader for test files that may be gzip- or zstd-compressed.
+ *
+ * The format is detected from the file's magic bytes, so callers just pass
+ * the path. A producer thread reads the file and, for compressed input,
+ * decompresses it into fixed-size blocks. Only kBlocksInFlight blocks exist:
+ * while the caller parses lines out of one block the producer fills the
+ * other, so decompression overlaps parsing and memory stays bounded however
+ * large the corpus is. Plain files take the same path, which overlaps the
+ * disk reads with parsing too.
+ *
+ * zstd support is compiled in only when building with ZSTD=1
+ * (-DDSAPROJ_WITH_ZSTD, linking libzstd).
+ */
+class StreamingLineReader {
+public:
+    /**
+     * @brief Size of each decompressed block handed to the line reader.
+     */
+    static const std::size_t kBlockBytes = 1 << 20;
+
+    /**
+     * @brief Number of blocks shared by the producer and the line reader.
+     */
+    static const std::size_t kBlocksInFlight = 2;
+
+    /**
+     * @brief Opens the file, detects its format and starts the producer thread.
+     *
+     * Use is_open() to check whether the file could be opened.
+     */
+    explicit StreamingLineReader(const std::string& filename);
+
+    /**
+     * @brief Stops the producer thread and closes the file.
+     */
+    ~StreamingLineReader();
+
+    StreamingLineReader(const StreamingLineReader&) = delete;
+    StreamingLineReader& operator=(const StreamingLineReader&) = delete;
+
+    /**
+     * @brief Returns true if the file was opened and its format is supported.
+     */
+    bool is_open() const { return file_ != nullptr; }
+
+    /**
+     * @brief Reads the next line, without its trailing '\n'.
+     *
+     * Behaves like std::getline: returns false only when no characters were
+     * left to read. A read or decompression error is reported on std::cerr
+     * and ends the stream; check failed() once getline() returns false.
+     */
+    bool getline(std::string& line);
+
+    /**
+     * @brief Returns true if the stream ended on a read or decompression
+     * error (including a truncated file) rather than at a clean end of file.
+     */
+    bool failed() const { return failed_.load(); }
+
+    /**
+     * @brief Stops the producer thread and closes the file early.
+     */
+    void close();
+
+    /**
+     * @brief Returns "plain", "gzip" or "zstd".
+     */
+    const char* format() const { return format_; }
+
+    /**
+     * @brief Returns the number of bytes read from disk so far.
+     */
+    std::uint64_t fileBytes() const { return fileBytes_.load(); }
+
+    /**
+     * @brief Returns the number of (decompressed) bytes produced so far.
+     */
+    std::uint64_t dataBytes() const { return dataBytes_.load(); }
+
+    /**
+     * @brief Returns the seconds the producer spent reading and decompressing.
+     *
+     * Time spent waiting for the line reader to hand back a block is not
+     * counted, so bytes / producerSeconds() is the decoder's own rate.
+     */
+    double producerSeconds() const { return producerSeconds_.load(); }
+
+    /**
+     * @brief Prints the format, byte counts and producer throughput.
+     *
+     * Call after the stream has been read to the end. Leaves std::cout's
+     * formatting as it found it.
+     */
+    void printInputSummary() const;
+
+private:
+    struct Block {
+        std::vector<char> data;
+        std::size_t size = 0;
+    };
+
+    void produce();
+    bool producePlain();
+    bool produceGzip();
+    bool produceZstd();
+
+    // Producer side of the block queue.
+    Block* acquireFree();
+    void publish(Block* block);
+
+    // Consumer side of the block queue.
+    bool nextBlock();
+
+    std::FILE* file_;
+    const char* format_;
+    std::thread producer_;
+
+    std::vector<Block> blocks_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Block*> free_;
+    std::deque<Block*> full_;
+    bool finished_;   // producer has published its last block
+    bool stopping_;   // consumer asked the producer to quit
+
+    Block* current_;  // block being consumed, or nullptr
+    std::size_t pos_;
+
+    double waitSeconds_;  // producer only: time blocked in acquireFree()
+
+    std::atomic<bool> failed_;
+    std::atomic<std::uint64_t> fileBytes_;
+    std::atomic<std::uint64_t> dataBytes_;
+    std::atomic<double> producerSeconds_;
+};
+
+#endif // STREAMINGLINEREADER_HPP
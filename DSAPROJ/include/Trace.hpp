@@ -0,0 +1,109 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief A single completed span recorded by the tracer.
+ *
+ * Names and argument names must point to storage that outlives the tracer
+ * (string literals in practice), so recording a span never allocates.
+ */
+struct TraceEvent {
+    const char* name;
+    const char* argName;   // nullptr when the span carries no argument
+    long long argValue;
+    std::int64_t startNs;  // relative to the tracer epoch
+    std::int64_t durationNs;
+};
+
+/**
+ * @brief Process-wide collector for timeline spans.
+ *
+ * Every thread that records a span gets its own fixed-size ring buffer, so
+ * recording never takes a lock; once a ring is full the oldest spans are
+ * overwritten. When tracing is disabled a span costs one relaxed atomic load.
+ *
+ * The collected spans are written as Chrome trace-event JSON, which can be
+ * opened in chrome://tracing or https://ui.perfetto.dev.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Number of spans each thread keeps before overwriting the oldest.
+     */
+    static const std::size_t kRingCapacity = 1 << 16;
+
+    /**
+     * @brief Turns span recording on or off for all threads.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Returns true if spans are currently being recorded.
+     */
+    static bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the time in nanoseconds since the tracer epoch.
+     */
+    static std::int64_t nowNs();
+
+    /**
+     * @brief Appends a completed span to the calling thread's ring buffer.
+     */
+    static void record(const char* name, const char* argName, long long argValue,
+                       std::int64_t startNs, std::int64_t endNs);
+
+    /**
+     * @brief Writes all recorded spans as Chrome trace-event JSON.
+     *
+     * Must not be called while other threads are still recording spans.
+     *
+     * @param filename The path of the JSON file to create.
+     * @return true if the file was written; false otherwise.
+     */
+    static bool writeChromeTrace(const std::string& filename);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief RAII helper that records the lifetime of a scope as one span.
+ *
+ * Usage:
+ * @code
+ *   {
+ *       TraceSpan span("parseArrayLine", "bytes", line.size());
+ *       ...
+ *   }
+ * @endcode
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, const char* argName = nullptr, long long argValue = 0)
+        : name_(name), argName_(argName), argValue_(argValue),
+          startNs_(Tracer::isEnabled() ? Tracer::nowNs() : -1) {}
+
+    ~TraceSpan() {
+        if (startNs_ >= 0) {
+            Tracer::record(name_, argName_, argValue_, startNs_, Tracer::nowNs());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* argName_;
+    long long argValue_;
+    std::int64_t startNs_;
+};
+
+#endif // TRACE_HPP
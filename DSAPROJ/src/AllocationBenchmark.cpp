@@ -0,0 +1,118 @@
+#include "AllocationBenchmark.hpp"
+#include "DynamicSolution.hpp"
+#include "GreedySolution.hpp"
+#include "HeightBuffer.hpp"
+#include "PerfCounter.hpp"
+#include "Profile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+// Timed runs per row after the warm-up; each row reports its median run.
+static const int REPETITIONS = 5;
+
+// One (allocation, solver) pair and the samples collected for it.
+struct AllocationRow {
+    std::string allocation;
+    std::string solver;
+    std::function<long long(const int*, std::size_t)> solve;
+    const int* heights;
+    std::vector<AllocationResult> samples;
+};
+
+// Helper function: time one solver call and count dTLB misses around it.
+static AllocationResult measure(const AllocationRow& row, std::size_t size) {
+    PerfCounter dtlb = PerfCounter::dtlbReadMisses();
+    AllocationResult r;
+    r.allocation = row.allocation;
+    r.solver = row.solver;
+
+    dtlb.start();
+    auto start = std::chrono::steady_clock::now();
+    volatile long long result = row.solve(row.heights, size);
+    auto end = std::chrono::steady_clock::now();
+    r.dtlbMisses = dtlb.stop();
+
+    r.result = result;
+    r.time = std::chrono::duration<double, std::milli>(end - start).count();
+    r.elementsPerSec = (r.time > 0.0) ? size / (r.time / 1000.0) : 0.0;
+    return r;
+}
+
+std::vector<AllocationResult> AllocationBenchmark::run(std::size_t size) {
+    std::vector<AllocationResult> results;
+    DynamicSolution dynamic;
+    GreedySolution greedy;
+    // One scratch for every Dynamic row, warmed by the warm-up pass, so the
+    // rows differ only in where the input lives rather than in mapping and
+    // faulting fresh max arrays on every call.
+    DynamicScratch scratch;
+    auto solveDynamic = [&dynamic, &scratch](const int* heights, std::size_t n) {
+        return dynamic.findWater(heights, n, scratch);
+    };
+    auto solveGreedy = [&greedy](const int* heights, std::size_t n) {
+        return greedy.findWater(heights, n);
+    };
+
+    std::cout << "Generating " << size << " heights..." << std::endl;
+    std::vector<int> heights = makeRandomWalkProfile(size);
+
+    // First-touch on this thread, which also runs the (single-threaded) solvers.
+    HeightBuffer thp = HeightBuffer::fromVector(heights, HugePageMode::Transparent);
+    HeightBuffer hugetlb = HeightBuffer::fromVector(heights, HugePageMode::Explicit);
+    std::string hugetlbLabel = hugetlb.usesExplicitHugePages() ? "hugetlb buffer"
+                                                               : "hugetlb->THP buffer";
+
+    std::vector<AllocationRow> rows = {
+        {"std::vector", "Dynamic", solveDynamic, heights.data(), {}},
+        {"std::vector", "Greedy", solveGreedy, heights.data(), {}},
+        {"THP buffer", "Dynamic", solveDynamic, thp.data(), {}},
+        {"THP buffer", "Greedy", solveGreedy, thp.data(), {}},
+        {hugetlbLabel, "Dynamic", solveDynamic, hugetlb.data(), {}},
+        {hugetlbLabel, "Greedy", solveGreedy, hugetlb.data(), {}},
+    };
+
+    // Warm-up: fault in the scratch and pull every input through the caches.
+    for (const auto& row : rows)
+        measure(row, size);
+    // Rotate the starting row each round so no allocation always runs first.
+    for (int rep = 0; rep < REPETITIONS; rep++) {
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            AllocationRow& row = rows[(i + rep) % rows.size()];
+            row.samples.push_back(measure(row, size));
+        }
+    }
+    for (auto& row : rows) {
+        std::sort(row.samples.begin(), row.samples.end(),
+                  [](const AllocationResult& a, const AllocationResult& b) { return a.time < b.time; });
+        results.push_back(row.samples[row.samples.size() / 2]);
+    }
+
+    std::cout << "\nAllocation Comparison (" << size << " elements, "
+              << "first-touched by the solving thread; median of " << REPETITIONS
+              << " warm runs, Dynamic scratch preallocated):\n";
+    std::cout << std::left
+              << std::setw(22) << "Allocation"
+              << std::setw(10) << "Solver"
+              << std::setw(16) << "Time(ms)"
+              << std::setw(18) << "Melem/s"
+              << std::setw(16) << "dTLB misses"
+              << std::setw(12) << "Result"
+              << std::endl;
+    std::cout << std::string(22+10+16+18+16+12, '-') << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::left
+                  << std::setw(22) << r.allocation
+                  << std::setw(10) << r.solver
+                  << std::setw(16) << std::fixed << std::setprecision(3) << r.time
+                  << std::setw(18) << std::fixed << std::setprecision(2) << r.elementsPerSec / 1e6;
+        if (r.dtlbMisses >= 0)
+            std::cout << std::setw(16) << r.dtlbMisses;
+        else
+            std::cout << std::setw(16) << "n/a";
+        std::cout << std::setw(12) << r.result << std::endl;
+    }
+    return results;
+}
@@ -1,5 +1,5 @@
 #include "CSVTestRunner.hpp"
-#include <fstream>
+#include "StreamingLineReader.hpp"
 #include <sstream>
 #include <iostream>
 #include <string>
@@ -33,7 +33,7 @@ int parseExpectedLine(const std::string& line) {
 
 bool CSVTestRunner::runTests(const std::string& filename,
                              const std::function<int(const std::vector<int>&)>& customFunction) {
-    std::ifstream infile(filename);
+    StreamingLineReader infile(filename);
     if (!infile.is_open()) {
         std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
         return false;
@@ -48,13 +48,13 @@ bool CSVTestRunner::runTests(const std::string& filename,
     int totalTests = 0;
     int passedTests = 0;
     
-    while (std::getline(infile, inputLine)) {
+    while (infile.getline(inputLine)) {
         // Skip empty lines.
         if (inputLine.empty())
             continue;
         
         // Read the expected output line.
-        if (!std::getline(infile, expectedLine)) {
+        if (!infile.getline(expectedLine)) {
             std::cerr << "Error: Expected output missing for test case " << testCase << std::endl;
             break;
         }
@@ -82,6 +82,13 @@ bool CSVTestRunner::runTests(const std::string& filename,
         testCase++;
     }
     
+    // A stream that ended on a read or decode error is a partial run.
+    bool incomplete = infile.failed();
+    if (incomplete) {
+        std::cerr << "Error: '" << filename << "' could not be read to the end; only the first "
+                  << totalTests << " test cases were read." << std::endl;
+    }
+    infile.printInputSummary();
     infile.close();
     
     // Calculate percentage of tests passed.
@@ -92,7 +99,7 @@ bool CSVTestRunner::runTests(const std::string& filename,
     std::cout << "Failed: " << (totalTests - passedTests) << std::endl;
     std::cout << "Percentage passed: " << percentPassed << "%" << std::endl;
     
-    return (passedTests == totalTests);
+    return !incomplete && (passedTests == totalTests);
 }
 
 const std::vector<double>& CSVTestRunner::getElapsedTimes() const {
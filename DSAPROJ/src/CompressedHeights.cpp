@@ -0,0 +1,213 @@
+#include "CompressedHeights.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+// On-disk magic and version for save()/load().
+static const char FILE_MAGIC[4] = {'D', 'S', 'H', 'C'};
+static const std::uint32_t FILE_VERSION = 1;
+
+// Zigzag maps small signed deltas to small unsigned values: 0,-1,1,-2 -> 0,1,2,3.
+static std::uint32_t zigzag(std::int32_t v) {
+    return (static_cast<std::uint32_t>(v) << 1) ^ static_cast<std::uint32_t>(v >> 31);
+}
+
+static std::int32_t unzigzag(std::uint32_t v) {
+    return static_cast<std::int32_t>(v >> 1) ^ -static_cast<std::int32_t>(v & 1);
+}
+
+static std::uint8_t bitWidth(std::uint32_t v) {
+    std::uint8_t width = 0;
+    while (v) {
+        width++;
+        v >>= 1;
+    }
+    return width;
+}
+
+const std::size_t CompressedHeights::kBlockSize;
+
+CompressedHeights::CompressedHeights() : size_(0) {}
+
+CompressedHeights CompressedHeights::encode(const std::vector<int>& heights) {
+    return encode(heights.data(), heights.size());
+}
+
+CompressedHeights CompressedHeights::encode(const int* heights, std::size_t size) {
+    CompressedHeights c;
+    c.size_ = size;
+    std::size_t blocks = (size + kBlockSize - 1) / kBlockSize;
+    c.headers_.reserve(blocks);
+
+    std::uint64_t bitPos = 0;  // bits written so far across all blocks
+    std::uint32_t zz[kBlockSize];
+    for (std::size_t b = 0; b < blocks; b++) {
+        const int* block = heights + b * kBlockSize;
+        std::size_t len = std::min(kBlockSize, size - b * kBlockSize);
+
+        BlockHeader h;
+        std::memset(&h, 0, sizeof(h));  // keep padding bytes deterministic on disk
+        h.first = block[0];
+        h.max = block[0];
+        h.sum = block[0];
+        std::uint32_t widest = 0;
+        for (std::size_t i = 1; i < len; i++) {
+            h.max = std::max(h.max, static_cast<std::int32_t>(block[i]));
+            h.sum += block[i];
+            zz[i] = zigzag(static_cast<std::int32_t>(
+                static_cast<std::uint32_t>(block[i]) - static_cast<std::uint32_t>(block[i - 1])));
+            widest |= zz[i];
+        }
+        h.width = bitWidth(widest);
+        h.word = static_cast<std::uint32_t>(bitPos / 64);
+        h.offset = static_cast<std::uint32_t>(bitPos % 64);
+        c.headers_.push_back(h);
+
+        // Append (len - 1) values of h.width bits, least significant bits first.
+        std::uint64_t needed = bitPos + static_cast<std::uint64_t>(h.width) * (len - 1);
+        c.words_.resize((needed + 63) / 64, 0);
+        for (std::size_t i = 1; i < len && h.width > 0; i++) {
+            std::uint64_t word = bitPos / 64;
+            unsigned shift = static_cast<unsigned>(bitPos % 64);
+            c.words_[word] |= static_cast<std::uint64_t>(zz[i]) << shift;
+            if (shift + h.width > 64)
+                c.words_[word + 1] |= static_cast<std::uint64_t>(zz[i]) >> (64 - shift);
+            bitPos += h.width;
+        }
+    }
+    return c;
+}
+
+std::size_t CompressedHeights::blockLength(std::size_t b) const {
+    return std::min(kBlockSize, size_ - b * kBlockSize);
+}
+
+void CompressedHeights::decodeBlock(std::size_t b, int* out) const {
+    const BlockHeader& h = headers_[b];
+    std::size_t len = blockLength(b);
+    std::uint32_t value = static_cast<std::uint32_t>(h.first);
+    out[0] = h.first;
+    if (h.width == 0) {
+        std::fill(out + 1, out + len, h.first);
+        return;
+    }
+
+    const std::uint64_t mask = (1ULL << h.width) - 1;
+    std::uint64_t bitPos = static_cast<std::uint64_t>(h.word) * 64 + h.offset;
+    for (std::size_t i = 1; i < len; i++) {
+        std::uint64_t word = bitPos / 64;
+        unsigned shift = static_cast<unsigned>(bitPos % 64);
+        std::uint64_t bits = words_[word] >> shift;
+        if (shift + h.width > 64)
+            bits |= words_[word + 1] << (64 - shift);
+        value += static_cast<std::uint32_t>(unzigzag(static_cast<std::uint32_t>(bits & mask)));
+        out[i] = static_cast<int>(value);
+        bitPos += h.width;
+    }
+}
+
+std::vector<int> CompressedHeights::decode() const {
+    std::vector<int> heights(size_ + kBlockSize);
+    for (std::size_t b = 0; b < headers_.size(); b++)
+        decodeBlock(b, heights.data() + b * kBlockSize);
+    heights.resize(size_);
+    return heights;
+}
+
+std::size_t CompressedHeights::blockPayloadBytes(std::size_t b) const {
+    const BlockHeader& h = headers_[b];
+    std::uint64_t bits = static_cast<std::uint64_t>(h.width) * (blockLength(b) - 1);
+    if (bits == 0)
+        return 0;
+    std::uint64_t words = (h.offset + bits + 63) / 64;
+    return static_cast<std::size_t>(words * sizeof(std::uint64_t));
+}
+
+std::size_t CompressedHeights::compressedBytes() const {
+    return headers_.size() * sizeof(BlockHeader) + words_.size() * sizeof(std::uint64_t);
+}
+
+double CompressedHeights::compressionRatio() const {
+    std::size_t bytes = compressedBytes();
+    return bytes > 0 ? static_cast<double>(size_ * sizeof(int)) / bytes : 0.0;
+}
+
+bool CompressedHeights::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
+        return false;
+    }
+    std::uint64_t size = size_;
+    std::uint64_t blocks = headers_.size();
+    std::uint64_t words = words_.size();
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(&blocks), sizeof(blocks));
+    out.write(reinterpret_cast<const char*>(&words), sizeof(words));
+    out.write(reinterpret_cast<const char*>(headers_.data()), blocks * sizeof(BlockHeader));
+    out.write(reinterpret_cast<const char*>(words_.data()), words * sizeof(std::uint64_t));
+    return static_cast<bool>(out);
+}
+
+bool CompressedHeights::load(const std::string& filename, CompressedHeights& out) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
+        return false;
+    }
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint64_t size = 0;
+    std::uint64_t blocks = 0;
+    std::uint64_t words = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    in.read(reinterpret_cast<char*>(&blocks), sizeof(blocks));
+    in.read(reinterpret_cast<char*>(&words), sizeof(words));
+    if (!in || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 || version != FILE_VERSION ||
+        blocks != (size + kBlockSize - 1) / kBlockSize) {
+        std::cerr << "Error: '" << filename << "' is not a compressed height file." << std::endl;
+        return false;
+    }
+    // Check the counts against the bytes actually left before allocating, so
+    // a corrupt header is rejected instead of throwing std::bad_alloc. The
+    // divisions keep a huge count from overflowing the byte computation.
+    std::streampos payloadStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::uint64_t remaining = static_cast<std::uint64_t>(in.tellg() - payloadStart);
+    in.seekg(payloadStart);
+    if (!in || blocks > remaining / sizeof(BlockHeader) ||
+        words > (remaining - blocks * sizeof(BlockHeader)) / sizeof(std::uint64_t) ||
+        blocks * sizeof(BlockHeader) + words * sizeof(std::uint64_t) != remaining) {
+        std::cerr << "Error: '" << filename << "' is truncated or has a corrupt header." << std::endl;
+        return false;
+    }
+
+    CompressedHeights c;
+    c.size_ = static_cast<std::size_t>(size);
+    c.headers_.resize(static_cast<std::size_t>(blocks));
+    c.words_.resize(static_cast<std::size_t>(words));
+    in.read(reinterpret_cast<char*>(c.headers_.data()), blocks * sizeof(BlockHeader));
+    in.read(reinterpret_cast<char*>(c.words_.data()), words * sizeof(std::uint64_t));
+    if (!in) {
+        std::cerr << "Error: '" << filename << "' is truncated." << std::endl;
+        return false;
+    }
+    // Reject headers that would make decodeBlock() read past the packed words.
+    for (std::size_t b = 0; b < c.headers_.size(); b++) {
+        const BlockHeader& h = c.headers_[b];
+        std::uint64_t end = static_cast<std::uint64_t>(h.word) * 64 + h.offset +
+                            static_cast<std::uint64_t>(h.width) * (c.blockLength(b) - 1);
+        if (h.width > 32 || h.offset >= 64 || end > words * 64) {
+            std::cerr << "Error: '" << filename << "' has a corrupt block header." << std::endl;
+            return false;
+        }
+    }
+    out = std::move(c);
+    return true;
+}
@@ -0,0 +1,86 @@
+#include "CompressedSolution.hpp"
+#include <algorithm>
+#include <limits>
+
+long long CompressedSolution::findWater(const CompressedHeights& heights, std::size_t* blocksDecoded,
+                                        std::size_t* bytesRead) const {
+    std::size_t decoded = 0;
+    std::size_t blocks = heights.blockCount();
+    if (heights.size() < 3) {
+        if (blocksDecoded)
+            *blocksDecoded = 0;
+        if (bytesRead)
+            *bytesRead = 0;
+        return 0;
+    }
+    // Packed-word bytes of decoded blocks; every header is read regardless.
+    std::size_t payload = 0;
+
+    // Find the first block holding the global maximum.
+    std::size_t peakBlock = 0;
+    for (std::size_t b = 1; b < blocks; b++) {
+        if (heights.header(b).max > heights.header(peakBlock).max)
+            peakBlock = b;
+    }
+
+    int buffer[CompressedHeights::kBlockSize];
+    long long totalWater = 0;
+
+    // Left of the peak block: water = running left max - height.
+    // Start below any height so the first block is always decoded.
+    long long leftMax = std::numeric_limits<long long>::min();
+    for (std::size_t b = 0; b < peakBlock; b++) {
+        const BlockHeader& h = heights.header(b);
+        long long len = static_cast<long long>(heights.blockLength(b));
+        if (h.max <= leftMax) {
+            totalWater += leftMax * len - h.sum;
+            continue;
+        }
+        heights.decodeBlock(b, buffer);
+        decoded++;
+        payload += heights.blockPayloadBytes(b);
+        for (long long i = 0; i < len; i++) {
+            leftMax = std::max<long long>(leftMax, buffer[i]);
+            totalWater += leftMax - buffer[i];
+        }
+    }
+
+    // Right of the peak block: water = running right max - height.
+    long long rightMax = std::numeric_limits<long long>::min();
+    for (std::size_t b = blocks - 1; b > peakBlock; b--) {
+        const BlockHeader& h = heights.header(b);
+        long long len = static_cast<long long>(heights.blockLength(b));
+        if (h.max <= rightMax) {
+            totalWater += rightMax * len - h.sum;
+            continue;
+        }
+        heights.decodeBlock(b, buffer);
+        decoded++;
+        payload += heights.blockPayloadBytes(b);
+        for (long long i = len - 1; i >= 0; i--) {
+            rightMax = std::max<long long>(rightMax, buffer[i]);
+            totalWater += rightMax - buffer[i];
+        }
+    }
+
+    // The peak block itself: sweep towards the peak from both ends.
+    heights.decodeBlock(peakBlock, buffer);
+    decoded++;
+    payload += heights.blockPayloadBytes(peakBlock);
+    long long len = static_cast<long long>(heights.blockLength(peakBlock));
+    long long peak = std::max_element(buffer, buffer + len) - buffer;
+    for (long long i = 0; i < peak; i++) {
+        leftMax = std::max<long long>(leftMax, buffer[i]);
+        totalWater += leftMax - buffer[i];
+    }
+    for (long long i = len - 1; i > peak; i--) {
+        rightMax = std::max<long long>(rightMax, buffer[i]);
+        totalWater += rightMax - buffer[i];
+    }
+
+    if (blocksDecoded)
+        *blocksDecoded = decoded;
+    if (bytesRead)
+        *bytesRead = blocks * sizeof(BlockHeader) + payload;
+    return totalWater;
+}
@@ -0,0 +1,117 @@
+#include "CompressionBenchmark.hpp"
+#include "CompressedHeights.hpp"
+#include "CompressedSolution.hpp"
+#include "DynamicSolution.hpp"
+#include "GreedySolution.hpp"
+#include "Profile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Scratch file used for the on-disk round trip.
+static const char* COMPRESSED_FILE = "profile.dshc";
+// Timed runs per solver after the warm-up; each row reports the median.
+static const int REPETITIONS = 5;
+
+// Helper function: warm up once, then return the median time in ms of
+// REPETITIONS calls; the result of the last call goes to `result`.
+static double medianMs(const std::function<long long()>& solve, long long& result) {
+    result = solve();
+    std::vector<double> times;
+    for (int rep = 0; rep < REPETITIONS; rep++) {
+        auto start = std::chrono::steady_clock::now();
+        volatile long long r = solve();  // Prevent compiler optimization.
+        auto end = std::chrono::steady_clock::now();
+        result = r;
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Helper function: print one row of the throughput table.
+static void printRow(const std::string& solver, double ms, std::size_t size,
+                     std::size_t bytesRead, long long result) {
+    double seconds = ms / 1000.0;
+    std::cout << std::left
+              << std::setw(14) << solver
+              << std::setw(14) << std::fixed << std::setprecision(3) << ms
+              << std::setw(14) << std::fixed << std::setprecision(2) << (seconds > 0 ? size / seconds / 1e6 : 0.0)
+              << std::setw(14) << std::fixed << std::setprecision(3) << (seconds > 0 ? bytesRead / seconds / 1e9 : 0.0)
+              << std::setw(12) << result
+              << std::endl;
+}
+
+bool CompressionBenchmark::run(std::size_t size, int maxStep) {
+    std::cout << "Generating " << size << " heights (max step " << maxStep << ")..." << std::endl;
+    std::vector<int> heights = makeRandomWalkProfile(size, maxStep);
+
+    auto start = std::chrono::steady_clock::now();
+    CompressedHeights compressed = CompressedHeights::encode(heights);
+    auto end = std::chrono::steady_clock::now();
+    double encodeMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Round-trip through disk so the loaded copy is what gets solved.
+    CompressedHeights loaded;
+    if (!compressed.save(COMPRESSED_FILE) || !CompressedHeights::load(COMPRESSED_FILE, loaded)) {
+        return false;
+    }
+    std::remove(COMPRESSED_FILE);
+
+    std::size_t rawBytes = size * sizeof(int);
+    std::cout << "\nCompression:\n";
+    std::cout << "Raw size:        " << std::fixed << std::setprecision(2) << rawBytes / 1e6 << " MB\n";
+    std::cout << "Compressed size: " << loaded.compressedBytes() / 1e6 << " MB ("
+              << loaded.blockCount() << " blocks of " << CompressedHeights::kBlockSize << ")\n";
+    std::cout << "Ratio:           " << loaded.compressionRatio() << "x\n";
+    std::cout << "Encode time:     " << std::setprecision(3) << encodeMs << " ms\n";
+
+    CompressedSolution compressedSolver;
+    DynamicSolution dynamic;
+    GreedySolution greedy;
+    // Preallocated and warmed by the warm-up call, so Dynamic is timed on
+    // the solve rather than on mapping its max arrays.
+    DynamicScratch scratch;
+    std::size_t blocksDecoded = 0;
+    std::size_t compressedBytesRead = 0;
+    long long compressedResult = 0;
+    long long dynamicResult = 0;
+    long long greedyResult = 0;
+
+    double compressedMs = medianMs([&]() {
+        return compressedSolver.findWater(loaded, &blocksDecoded, &compressedBytesRead);
+    }, compressedResult);
+    double dynamicMs = medianMs([&]() {
+        return dynamic.findWater(heights.data(), heights.size(), scratch);
+    }, dynamicResult);
+    double greedyMs = medianMs([&]() {
+        return greedy.findWater(heights.data(), heights.size());
+    }, greedyResult);
+
+    std::cout << "\nSolve Throughput (median of " << REPETITIONS << " warm runs):\n";
+    std::cout << std::left
+              << std::setw(14) << "Solver"
+              << std::setw(14) << "Time(ms)"
+              << std::setw(14) << "Melem/s"
+              << std::setw(14) << "GB/s read"
+              << std::setw(12) << "Result"
+              << std::endl;
+    std::cout << std::string(14*4+12, '-') << std::endl;
+    printRow("Compressed", compressedMs, size, compressedBytesRead, compressedResult);
+    printRow("Dynamic", dynamicMs, size, rawBytes, dynamicResult);
+    printRow("Greedy", greedyMs, size, rawBytes, greedyResult);
+    std::cout << "Blocks decoded by Compressed: " << blocksDecoded << " of " << loaded.blockCount()
+              << " (the rest were answered from block headers); "
+              << std::fixed << std::setprecision(3) << compressedBytesRead / 1e6 << " of "
+              << loaded.compressedBytes() / 1e6 << " MB read" << std::endl;
+
+    bool agree = (compressedResult == dynamicResult) && (compressedResult == greedyResult);
+    if (!agree) {
+        std::cerr << "Error: solvers disagree on the compressed profile." << std::endl;
+    }
+    return agree;
+}
@@ -0,0 +1,88 @@
+#include "CycleTimer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#ifdef CYCLETIMER_HAS_TSC
+#include <cpuid.h>
+#endif
+
+// A batch should last at least this long, and at least OVERHEAD_FACTOR times
+// the cost of reading the clock, so the read cost stays below 0.1%.
+static const double MIN_BATCH_NS = 20000.0;
+static const double OVERHEAD_FACTOR = 1000.0;
+
+// How long to spin while calibrating the TSC against steady_clock.
+static const double CALIBRATION_NS = 20e6;
+
+// Helper function: true if CPUID reports an invariant TSC (leaf 0x80000007, EDX bit 8).
+static bool hasInvariantTsc() {
+#ifdef CYCLETIMER_HAS_TSC
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+        return false;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+const CycleTimer& CycleTimer::instance() {
+    static const CycleTimer timer;
+    return timer;
+}
+
+std::uint64_t CycleTimer::steadyNow() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+CycleTimer::CycleTimer() : usesTsc_(hasInvariantTsc()), ticksPerNs_(1.0), overheadTicks_(0.0) {
+    if (usesTsc_) {
+        // Calibrate the TSC frequency against steady_clock.
+        std::uint64_t ns0 = steadyNow();
+        std::uint64_t t0 = start();
+        std::uint64_t ns1 = ns0;
+        while (static_cast<double>(ns1 - ns0) < CALIBRATION_NS)
+            ns1 = steadyNow();
+        std::uint64_t t1 = stop();
+        ticksPerNs_ = static_cast<double>(t1 - t0) / static_cast<double>(ns1 - ns0);
+        if (!(ticksPerNs_ > 0.0)) {
+            usesTsc_ = false;
+            ticksPerNs_ = 1.0;
+        }
+    }
+
+    // The overhead is the cheapest of many empty start()/stop() pairs.
+    std::uint64_t best = ~0ULL;
+    for (int i = 0; i < 1000; i++) {
+        std::uint64_t a = start();
+        std::uint64_t b = stop();
+        best = std::min(best, b - a);
+    }
+    overheadTicks_ = static_cast<double>(best);
+}
+
+double CycleTimer::netTicks(std::uint64_t startTicks, std::uint64_t stopTicks) const {
+    double ticks = static_cast<double>(stopTicks - startTicks) - overheadTicks_;
+    return ticks > 0.0 ? ticks : 0.0;
+}
+
+double CycleTimer::batchTargetTicks() const {
+    return std::max(overheadTicks_ * OVERHEAD_FACTOR, MIN_BATCH_NS * ticksPerNs_);
+}
+
+std::size_t CycleTimer::batchSizeFor(std::size_t elements, double callTicks) const {
+    double target = batchTargetTicks();
+    // Without a measurement, assume roughly one nanosecond per element.
+    double estimate = callTicks > 0.0 ? callTicks
+                                      : static_cast<double>(std::max<std::size_t>(elements, 1)) * ticksPerNs_;
+    double batch = std::ceil(target / estimate);
+    if (batch < 1.0)
+        return 1;
+    if (batch > static_cast<double>(kMaxBatch))
+        return kMaxBatch;
+    return static_cast<std::size_t>(batch);
+}
@@ -1,32 +1,73 @@
 #include <vector>
 #include "DynamicSolution.hpp"
 using namespace std;
-int DynamicSolution::findWater(const std::vector<int>& vec) const{
 
-int size = vec.size();
+// Scratch arrays at least this long are huge-page backed HeightBuffers.
+static const std::size_t HUGE_SCRATCH_THRESHOLD = 1 << 20;
 
-if(size<3){
-    return 0;
-}
-vector<int> leftMax(size);
-vector<int> rightMax(size);
+// Helper function: fills the max arrays and sums the water; size >= 3.
+static long long sweep(const int* vec, std::size_t size, int* leftMax, int* rightMax){
 //fill left max
 leftMax[0] = vec[0];
-for(int i=1;i<=size-1;i++){
+for(std::size_t i=1;i<=size-1;i++){
 leftMax[i] = max(leftMax[i-1],vec[i]);
 }
 //fill righMax
 rightMax[size-1] = vec[size-1];
-for(int i = size-2; i >= 0;i--){
+for(std::size_t i = size-1; i-- > 0;){
 rightMax[i] = max(rightMax[i+1],vec[i]);
 }
 //calculate total water
-int totalWater = 0;
-for(int i=0;i<size-1;i++){
+long long totalWater = 0;
+for(std::size_t i=0;i<size-1;i++){
     int trapped = min(leftMax[i], rightMax[i]) -vec[i];
     if(trapped > 0){
         totalWater += trapped;
     }
 }
 return totalWater;
+}
+
+int DynamicSolution::findWater(const std::vector<int>& vec) const{
+    return static_cast<int>(findWater(vec.data(), vec.size()));
+}
+
+long long DynamicSolution::findWater(const int* vec, std::size_t n, DynamicScratch& scratch) const{
+if(n<3){
+    return 0;
+}
+if(scratch.leftMax.size() < n){
+    // Grow geometrically so a slowly rising request size does not remap every call.
+    std::size_t capacity = max(n, 2 * scratch.leftMax.size());
+    scratch.leftMax = HeightBuffer(capacity);
+    scratch.rightMax = HeightBuffer(capacity);
+}
+return sweep(vec, n, scratch.leftMax.data(), scratch.rightMax.data());
+}
+
+long long DynamicSolution::findWater(const int* vec, std::size_t n) const{
+
+std::size_t size = n;
+
+if(size<3){
+    return 0;
+}
+vector<int> leftMaxVec;
+vector<int> rightMaxVec;
+HeightBuffer leftMaxBuf;
+HeightBuffer rightMaxBuf;
+int* leftMax;
+int* rightMax;
+if(n >= HUGE_SCRATCH_THRESHOLD){
+    leftMaxBuf = HeightBuffer(n);
+    rightMaxBuf = HeightBuffer(n);
+    leftMax = leftMaxBuf.data();
+    rightMax = rightMaxBuf.data();
+}else{
+    leftMaxVec.resize(size);
+    rightMaxVec.resize(size);
+    leftMax = leftMaxVec.data();
+    rightMax = rightMaxVec.data();
+}
+return sweep(vec, size, leftMax, rightMax);
 }
\ No newline at end of file
@@ -1,18 +1,22 @@
 #include "GreedySolution.hpp"
 #include <vector>
 int GreedySolution::findWater(const std::vector<int>& vec) const{
+    return static_cast<int>(findWater(vec.data(), vec.size()));
+}
+
+long long GreedySolution::findWater(const int* vec, std::size_t n) const{
       
-   int size = vec.size();
+   std::size_t size = n;
    if(size < 3){
     return 0;
    }
 
    //Pointer Decleration
-    int left = 0;
+    std::size_t left = 0;
     int rightMax =0;
     int leftMax = 0;
-    int totalWater = 0;
-    int right = size-1;
+    long long totalWater = 0;
+    std::size_t right = size-1;
 
    //Main Loop
    while(left < right){
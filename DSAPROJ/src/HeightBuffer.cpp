@@ -0,0 +1,152 @@
+#include "HeightBuffer.hpp"
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace {
+
+const std::size_t kElementsPerHugePage = HeightBuffer::kAlignment / sizeof(int);
+
+// Runs fn(begin, end) for every chunk, one thread per chunk. The calling
+// thread handles chunk 0 so a single-thread touch spawns nothing.
+template <typename Fn>
+void forEachChunk(std::size_t size, unsigned threads, const Fn& fn) {
+    if (threads < 1)
+        threads = 1;
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        std::size_t begin = HeightBuffer::chunkBegin(size, t, threads);
+        std::size_t end = HeightBuffer::chunkBegin(size, t + 1, threads);
+        if (begin < end)
+            workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+    }
+    fn(0, HeightBuffer::chunkBegin(size, 1, threads));
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // namespace
+
+HeightBuffer::HeightBuffer()
+    : data_(nullptr), size_(0), mapping_(nullptr), mappingBytes_(0), explicitHuge_(false) {}
+
+HeightBuffer::HeightBuffer(std::size_t size, HugePageMode mode, unsigned touchThreads)
+    : HeightBuffer() {
+    allocate(size, mode);
+    int* data = data_;
+    forEachChunk(size_, touchThreads, [data](std::size_t begin, std::size_t end) {
+        std::memset(data + begin, 0, (end - begin) * sizeof(int));
+    });
+}
+
+HeightBuffer HeightBuffer::fromVector(const std::vector<int>& heights,
+                                      HugePageMode mode, unsigned touchThreads) {
+    HeightBuffer buffer;
+    buffer.allocate(heights.size(), mode);
+    int* data = buffer.data_;
+    const int* src = heights.data();
+    forEachChunk(buffer.size_, touchThreads, [data, src](std::size_t begin, std::size_t end) {
+        std::memcpy(data + begin, src + begin, (end - begin) * sizeof(int));
+    });
+    return buffer;
+}
+
+HeightBuffer::~HeightBuffer() {
+    release();
+}
+
+HeightBuffer::HeightBuffer(HeightBuffer&& other) noexcept
+    : data_(other.data_), size_(other.size_), mapping_(other.mapping_),
+      mappingBytes_(other.mappingBytes_), explicitHuge_(other.explicitHuge_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapping_ = nullptr;
+    other.mappingBytes_ = 0;
+    other.explicitHuge_ = false;
+}
+
+HeightBuffer& HeightBuffer::operator=(HeightBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(mappingBytes_, other.mappingBytes_);
+        std::swap(explicitHuge_, other.explicitHuge_);
+    }
+    return *this;
+}
+
+std::size_t HeightBuffer::chunkBegin(std::size_t size, unsigned index, unsigned chunks) {
+    if (chunks < 1)
+        chunks = 1;
+    if (index >= chunks)
+        return size;
+    // Split whole huge pages evenly so no page is shared between two threads.
+    std::size_t pages = (size + kElementsPerHugePage - 1) / kElementsPerHugePage;
+    std::size_t page = pages * index / chunks;
+    return std::min(size, page * kElementsPerHugePage);
+}
+
+void HeightBuffer::allocate(std::size_t size, HugePageMode mode) {
+    size_ = size;
+    if (size == 0)
+        return;
+
+    std::size_t bytes = size * sizeof(int);
+    std::size_t rounded = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+
+    if (mode == HugePageMode::Explicit) {
+        void* p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            mapping_ = p;
+            mappingBytes_ = rounded;
+            data_ = static_cast<int*>(p);
+            explicitHuge_ = true;
+            return;
+        }
+        // Pool pages are reserved at mmap time, so failure means the pool is
+        // too small: fall back to transparent huge pages.
+        mode = HugePageMode::Transparent;
+    }
+
+    // Over-map by one huge page so the start can be aligned, then trim.
+    std::size_t mapped = rounded + kAlignment;
+    void* p = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        size_ = 0;
+        throw std::bad_alloc();
+    }
+    std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(p);
+    std::uintptr_t aligned = (raw + kAlignment - 1) / kAlignment * kAlignment;
+    std::size_t head = aligned - raw;
+    std::size_t tail = mapped - head - rounded;
+    if (head > 0)
+        munmap(p, head);
+    if (tail > 0)
+        munmap(reinterpret_cast<void*>(aligned + rounded), tail);
+
+    mapping_ = reinterpret_cast<void*>(aligned);
+    mappingBytes_ = rounded;
+    data_ = static_cast<int*>(mapping_);
+    if (mode == HugePageMode::Transparent)
+        madvise(mapping_, mappingBytes_, MADV_HUGEPAGE);
+    else
+        madvise(mapping_, mappingBytes_, MADV_NOHUGEPAGE);
+}
+
+void HeightBuffer::release() {
+    if (mapping_)
+        munmap(mapping_, mappingBytes_);
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    mappingBytes_ = 0;
+    explicitHuge_ = false;
+}
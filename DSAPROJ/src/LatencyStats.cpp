@@ -0,0 +1,36 @@
+#include "LatencyStats.hpp"
+#include <algorithm>
+
+void LatencyStats::record(double micros) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_.size() < kCapacity) {
+        samples_.push_back(micros);
+    } else {
+        samples_[next_] = micros;
+        next_ = (next_ + 1) % kCapacity;
+    }
+    total_++;
+}
+
+std::size_t LatencyStats::count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+
+std::vector<double> LatencyStats::percentiles(const std::vector<double>& ps) const {
+    std::vector<double> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sorted = samples_;
+    }
+    std::vector<double> result(ps.size(), 0.0);
+    if (sorted.empty())
+        return result;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < ps.size(); i++) {
+        // Nearest-rank percentile.
+        double rank = ps[i] / 100.0 * (sorted.size() - 1);
+        result[i] = sorted[static_cast<std::size_t>(rank + 0.5)];
+    }
+    return result;
+}
@@ -0,0 +1,137 @@
+#include "MachineProbe.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// Smallest buffer used for the DRAM probe; grown to twice the last-level
+// cache where that is larger, up to MAX_DRAM_BYTES.
+static const std::size_t DRAM_BYTES = 256u * 1024 * 1024;
+static const std::size_t MAX_DRAM_BYTES = 1024u * 1024 * 1024;
+// Bytes each bandwidth probe reads in total, so small levels are rescanned.
+static const std::size_t SCAN_TOTAL_BYTES = 256u * 1024 * 1024;
+// Cache sizes assumed when sysconf does not report them.
+static const std::size_t DEFAULT_L1_BYTES = 32u * 1024;
+static const std::size_t DEFAULT_L2_BYTES = 1024u * 1024;
+static const std::size_t DEFAULT_L3_BYTES = 32u * 1024 * 1024;
+// Array used by the scalar probe; fits in L1.
+static const int SCALAR_ELEMENTS = 1024;
+// Each probe keeps the best of this many repetitions.
+static const int REPETITIONS = 3;
+
+// Helper function: cache size reported by sysconf, or `fallback`.
+static std::size_t cacheBytes(int name, std::size_t fallback) {
+    long bytes = sysconf(name);
+    return bytes > 0 ? static_cast<std::size_t>(bytes) : fallback;
+}
+
+// Helper function: bytes per second when one thread scans the first `bytes`
+// of `buffer` until SCAN_TOTAL_BYTES have been read.
+static double scanRate(const char* buffer, std::size_t bytes) {
+    std::size_t passes = std::max<std::size_t>(1, SCAN_TOTAL_BYTES / bytes);
+    // Warm-up pass, so the cache levels start filled.
+    volatile const void* found = std::memchr(buffer, 1, bytes);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t p = 0; p < passes; p++) {
+        // The buffer is all zeros, so memchr reads every byte.
+        found = std::memchr(buffer, 1, bytes);
+    }
+    auto end = std::chrono::steady_clock::now();
+    (void)found;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(bytes) * passes / seconds;
+}
+
+// Helper function: combined bytes per second when `threads` threads each
+// scan their own slice of `buffer` once, all at the same time.
+static double allCoreScanRate(const char* buffer, std::size_t bytes, unsigned threads) {
+    std::size_t slice = bytes / threads;
+    std::vector<std::thread> scanners;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; t++) {
+        scanners.emplace_back([buffer, slice, t]() {
+            volatile const void* found = std::memchr(buffer + t * slice, 1, slice);
+            (void)found;
+        });
+    }
+    for (auto& scanner : scanners)
+        scanner.join();
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(slice) * threads / seconds;
+}
+
+// Helper function: element accesses per second of a scalar loop that loads
+// each element and adds it into one of four independent accumulators.
+static double scalarRate() {
+    std::vector<int> values(SCALAR_ELEMENTS);
+    for (int i = 0; i < SCALAR_ELEMENTS; i++)
+        values[i] = (i * 7919) % 1000;
+    const int* v = values.data();
+    const int passes = 4000;
+    long long s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (int i = 0; i < SCALAR_ELEMENTS; i += 4) {
+            s0 += v[i];
+            s1 += v[i + 1];
+            s2 += v[i + 2];
+            s3 += v[i + 3];
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = s0 + s1 + s2 + s3;  // Prevent compiler optimization.
+    (void)sink;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(passes) * SCALAR_ELEMENTS / seconds;
+}
+
+const MachineCeilings& MachineProbe::ceilings() {
+    static const MachineCeilings measured = measure();
+    return measured;
+}
+
+const BandwidthCeiling& MachineCeilings::bandwidthFor(std::size_t workingSetBytes) const {
+    for (const auto& ceiling : bandwidth) {
+        if (workingSetBytes <= ceiling.capacityBytes)
+            return ceiling;
+    }
+    return bandwidth.back();
+}
+
+MachineCeilings MachineProbe::measure() {
+    MachineCeilings c;
+    std::size_t l1 = cacheBytes(_SC_LEVEL1_DCACHE_SIZE, DEFAULT_L1_BYTES);
+    std::size_t l2 = cacheBytes(_SC_LEVEL2_CACHE_SIZE, DEFAULT_L2_BYTES);
+    std::size_t l3 = cacheBytes(_SC_LEVEL3_CACHE_SIZE, DEFAULT_L3_BYTES);
+    std::size_t dram = std::min(std::max(DRAM_BYTES, 2 * l3), MAX_DRAM_BYTES);
+
+    // Zero-filled and touched up front so page faults are not measured.
+    std::vector<char> buffer(dram, 0);
+    c.bandwidth = {
+        {"L1", l1, 0.0},
+        {"L2", l2, 0.0},
+        {"L3", l3, 0.0},
+        {"DRAM", std::numeric_limits<std::size_t>::max(), 0.0},
+    };
+    for (auto& ceiling : c.bandwidth) {
+        // Half the level leaves room for everything else the core touches.
+        std::size_t bytes = (ceiling.capacityBytes > dram) ? dram : ceiling.capacityBytes / 2;
+        for (int r = 0; r < REPETITIONS; r++)
+            ceiling.bytesPerSec = std::max(ceiling.bytesPerSec, scanRate(buffer.data(), bytes));
+    }
+
+    c.threads = std::max(1u, std::thread::hardware_concurrency());
+    c.allCoreBytesPerSec = 0.0;
+    for (int r = 0; r < REPETITIONS; r++)
+        c.allCoreBytesPerSec = std::max(c.allCoreBytesPerSec, allCoreScanRate(buffer.data(), dram, c.threads));
+
+    double scalarBest = 0.0;
+    for (int r = 0; r < REPETITIONS; r++)
+        scalarBest = std::max(scalarBest, scalarRate());
+    c.scalarElementsPerSec = scalarBest;
+    return c;
+}
@@ -2,11 +2,68 @@
 #include "NaiveSolution.hpp"
 #include "DynamicSolution.hpp"
 #include "GreedySolution.hpp"
+#include "AllocationBenchmark.hpp"
+#include "CompressionBenchmark.hpp"
+#include "MachineProbe.hpp"
+#include "SlidingWindowBenchmark.hpp"
 #include <iostream>
 #include <functional>
 #include <iomanip>
+#include <limits>
 #include <vector>
 #include <fstream>
+#include <sstream>
+
+// Memory traffic of one findWater call, in 4-byte element accesses:
+// Naive rescans both sides for every index (~n^2), Dynamic reads the input
+// three times and writes then reads two max arrays (7n), Greedy reads each
+// height once (n).
+static double elementAccesses(const std::string& label, int n) {
+    double size = n;
+    if (label == "Naive")
+        return (size - 1.0) * (size + 1.0);
+    if (label == "Dynamic")
+        return 7.0 * size;
+    return size;
+}
+
+// Distinct bytes one findWater call touches: the input, plus the two max
+// arrays for Dynamic. Decides which cache level serves the traffic.
+static std::size_t workingSetBytes(const std::string& label, int n) {
+    std::size_t arrays = (label == "Dynamic") ? 3 : 1;
+    return arrays * static_cast<std::size_t>(n) * sizeof(int);
+}
+
+// Formats "GB/s (%BW level) Melem/s (%scalar)" for one solver on one test
+// case, against the bandwidth of the level its working set fits in.
+static std::string rooflineCell(const std::string& label, int n, double timeMs, bool timedOut,
+                                const MachineCeilings& ceilings) {
+    if (timedOut || timeMs <= 0.0 || n < 3)
+        return "n/a";
+    double accesses = elementAccesses(label, n);
+    double seconds = timeMs / 1000.0;
+    double bytesPerSec = accesses * sizeof(int) / seconds;
+    double elementsPerSec = accesses / seconds;
+    const BandwidthCeiling& level = ceilings.bandwidthFor(workingSetBytes(label, n));
+    std::ostringstream cell;
+    cell << std::fixed << std::setprecision(2) << bytesPerSec / 1e9 << " ("
+         << std::setprecision(0) << 100.0 * bytesPerSec / level.bytesPerSec << "% " << level.level << ") "
+         << std::setprecision(1) << elementsPerSec / 1e6 << " ("
+         << std::setprecision(0) << 100.0 * elementsPerSec / ceilings.scalarElementsPerSec << "%)";
+    return cell.str();
+}
+
+// Formats one solver's read rate as a percentage of all-core DRAM
+// bandwidth, i.e. how much of the machine a parallel version could add.
+static std::string allCoreShare(const std::string& label, int n, double timeMs, bool timedOut,
+                                const MachineCeilings& ceilings) {
+    if (timedOut || timeMs <= 0.0 || n < 3)
+        return "n/a";
+    double bytesPerSec = elementAccesses(label, n) * sizeof(int) / (timeMs / 1000.0);
+    std::ostringstream share;
+    share << std::fixed << std::setprecision(0) << 100.0 * bytesPerSec / ceilings.allCoreBytesPerSec << "%";
+    return share.str();
+}
 
 // Constructor
 Menu::Menu(const std::string& testFile) : testFile(testFile) {}
@@ -20,7 +77,11 @@ void Menu::run() {
         std::cout << "2. Run Dynamic Tests\n";
         std::cout << "3. Run Greedy Tests\n";
         std::cout << "4. Run All Tests and Compare Results\n";
-        std::cout << "5. Exit\n";
+        std::cout << "5. Run Allocation Benchmark (vector vs huge pages)\n";
+        std::cout << "6. Run Compression Benchmark\n";
+        std::cout << "7. Run Sliding-Window Monitor Benchmark\n";
+        std::cout << "8. Measure Test File Input Throughput\n";
+        std::cout << "9. Exit\n";
         std::cout << "Enter your choice: ";
         std::cin >> choice;
 
@@ -38,12 +99,24 @@ void Menu::run() {
                 runAllTestsAndCompare();
                 break;
             case 5:
+                runAllocationBenchmark();
+                break;
+            case 6:
+                runCompressionBenchmark();
+                break;
+            case 7:
+                runSlidingWindowBenchmark();
+                break;
+            case 8:
+                runInputThroughput();
+                break;
+            case 9:
                 std::cout << "Exiting...\n";
                 break;
             default:
                 std::cout << "Invalid choice. Please select a valid option.\n";
         }
-    } while (choice != 5);
+    } while (choice != 9);
 }
 
 // Run tests only for the Naive solution.
@@ -59,7 +132,7 @@ void Menu::runNaiveTests() {
     // Optionally, print each test result.
     for (const auto& tr : results) {
         std::cout << "Test " << tr.testCase << " (size " << tr.inputSize << "): " 
-                  << tr.naiveTime << " ms, result: " << tr.naiveResult 
+                  << std::fixed << std::setprecision(7) << tr.naiveTime << " ms, result: " << tr.naiveResult 
                   << (tr.naivePassed ? " (PASS)" : " (FAIL)") << "\n";
     }
 }
@@ -76,7 +149,7 @@ void Menu::runDynamicTests() {
 
     for (const auto& tr : results) {
         std::cout << "Test " << tr.testCase << " (size " << tr.inputSize << "): " 
-                  << tr.dynamicTime << " ms, result: " << tr.dynamicResult 
+                  << std::fixed << std::setprecision(7) << tr.dynamicTime << " ms, result: " << tr.dynamicResult 
                   << (tr.dynamicPassed ? " (PASS)" : " (FAIL)") << "\n";
     }
 }
@@ -93,7 +166,7 @@ void Menu::runGreedyTests() {
 
     for (const auto& tr : results) {
         std::cout << "Test " << tr.testCase << " (size " << tr.inputSize << "): " 
-                  << tr.greedyTime << " ms, result: " << tr.greedyResult 
+                  << std::fixed << std::setprecision(7) << tr.greedyTime << " ms, result: " << tr.greedyResult 
                   << (tr.greedyPassed ? " (PASS)" : " (FAIL)") << "\n";
     }
 }
@@ -140,5 +213,87 @@ void Menu::runAllTestsAndCompare() {
                   << std::setw(20) << std::fixed << std::setprecision(6) << tr.greedyTime
                   << std::endl;
     }
+
+    // Put each time next to the machine's ceilings: a solver near 100% of
+    // the bandwidth of the level its working set lives in is memory-bound,
+    // one near 100% of scalar throughput is compute-bound.
+    std::cout << "\nProbing machine ceilings...\n";
+    const MachineCeilings& ceilings = MachineProbe::ceilings();
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& level : ceilings.bandwidth) {
+        std::cout << std::left << std::setw(5) << level.level << "read bandwidth: "
+                  << level.bytesPerSec / 1e9 << " GB/s";
+        if (level.capacityBytes != std::numeric_limits<std::size_t>::max())
+            std::cout << " (working sets up to " << level.capacityBytes / 1024 << " KiB)";
+        std::cout << "\n";
+    }
+    std::cout << "All-core DRAM bandwidth:  " << ceilings.allCoreBytesPerSec / 1e9 <<  " GB/s (scanning threads: "
+              << ceilings.threads << ")\n";
+    std::cout << "Scalar throughput:        " << ceilings.scalarElementsPerSec / 1e6 << " Melem/s per core\n";
+
+    std::cout << "\nRoofline Table: GB/s (% of single-core bandwidth of the cache level or DRAM the"
+              << " working set fits in) Melem/s (% of scalar throughput); All-core is each solver's"
+              << " read rate as % of all-core DRAM bandwidth (Naive/Dynamic/Greedy)\n";
+    std::cout << std::left
+              << std::setw(8) << "Test"
+              << std::setw(12) << "InputSize"
+              << std::setw(32) << "Naive"
+              << std::setw(32) << "Dynamic"
+              << std::setw(32) << "Greedy"
+              << std::setw(18) << "All-core"
+              << std::endl;
+    std::cout << std::string(8+12+32+32+32+18, '-') << std::endl;
+    for (const auto& tr : results) {
+        std::cout << std::left
+                  << std::setw(8) << tr.testCase
+                  << std::setw(12) << tr.inputSize
+                  << std::setw(32) << rooflineCell("Naive", tr.inputSize, tr.naiveTime, tr.naiveResult == -1, ceilings)
+                  << std::setw(32) << rooflineCell("Dynamic", tr.inputSize, tr.dynamicTime, tr.dynamicResult == -1, ceilings)
+                  << std::setw(32) << rooflineCell("Greedy", tr.inputSize, tr.greedyTime, tr.greedyResult == -1, ceilings)
+                  << std::setw(18) << (allCoreShare("Naive", tr.inputSize, tr.naiveTime, tr.naiveResult == -1, ceilings) + "/"
+                                       + allCoreShare("Dynamic", tr.inputSize, tr.dynamicTime, tr.dynamicResult == -1, ceilings) + "/"
+                                       + allCoreShare("Greedy", tr.inputSize, tr.greedyTime, tr.greedyResult == -1, ceilings))
+                  << std::endl;
+    }
 }
 
+// Compare solver throughput on std::vector input against huge-page buffers.
+void Menu::runAllocationBenchmark() {
+    std::size_t size;
+    std::cout << "Enter number of heights (e.g. 100000000): ";
+    std::cin >> size;
+
+    AllocationBenchmark benchmark;
+    std::cout << "\n--- Running Allocation Benchmark ---\n";
+    benchmark.run(size);
+}
+
+// Compare solving on compressed heights against the raw-array solvers.
+void Menu::runCompressionBenchmark() {
+    std::size_t size;
+    int maxStep;
+    std::cout << "Enter number of heights (e.g. 100000000): ";
+    std::cin >> size;
+    std::cout << "Enter largest step between neighbours (e.g. 8): ";
+    std::cin >> maxStep;
+
+    CompressionBenchmark benchmark;
+    std::cout << "\n--- Running Compression Benchmark ---\n";
+    benchmark.run(size, maxStep);
+}
+
+// Measure the streaming trapped-water monitor across window sizes.
+void Menu::runSlidingWindowBenchmark() {
+    SlidingWindowBenchmark benchmark;
+    std::cout << "\n--- Running Sliding-Window Monitor Benchmark ---\n";
+    if (benchmark.run()) {
+        std::cout << "Monitor matches GreedySolution on all checked windows.\n";
+    }
+}
+
+// Read and parse the test file without solving to measure the input rate.
+void Menu::runInputThroughput() {
+    MultiSolutionTestRunner runner;
+    std::cout << "\n--- Measuring Input Throughput ---\n";
+    runner.measureInputThroughput(testFile);
+}
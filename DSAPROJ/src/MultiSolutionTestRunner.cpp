@@ -1,10 +1,13 @@
 #include "MultiSolutionTestRunner.hpp"
-#include <fstream>
+#include "CycleTimer.hpp"
+#include "StreamingLineReader.hpp"
+#include "Trace.hpp"
 #include <sstream>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <cstdlib>
+#include <algorithm>
 #include <chrono>
 #include <iomanip> // For std::fixed and std::setprecision
 
@@ -13,6 +16,7 @@ static const int ITERATIONS = 50;
 
 // Helper function: parse a comma-separated line into a vector of ints.
 static std::vector<int> parseArrayLine(const std::string& line) {
+    TraceSpan span("parseArrayLine", "bytes", static_cast<long long>(line.size()));
     std::vector<int> result;
     std::stringstream ss(line);
     std::string token;
@@ -35,38 +39,106 @@ static int parseExpectedLine(const std::string& line) {
     return value;
 }
 
+// Helper function: read one line from the test file, recorded as a trace span.
+static bool readLine(StreamingLineReader& infile, std::string& line) {
+    TraceSpan span("fileRead");
+    return infile.getline(line);
+}
+
+// Helper function: report a test file that ended on a read or decode error,
+// so a partial run is not mistaken for a complete one. Returns true if so.
+static bool reportInputFailure(const StreamingLineReader& infile, const std::string& filename,
+                               int testsRead) {
+    if (!infile.failed())
+        return false;
+    std::cerr << "Error: '" << filename << "' could not be read to the end; only the first "
+              << testsRead << " test cases were read." << std::endl;
+    return true;
+}
+
+// Helper function: map a solution label to a trace span name with static storage.
+static const char* solveSpanName(const std::string& label) {
+    if (label == "Naive")
+        return "solve:Naive";
+    if (label == "Dynamic")
+        return "solve:Dynamic";
+    if (label == "Greedy")
+        return "solve:Greedy";
+    return "solve";
+}
+
 // Updated helper function to run a test function with timeout.
-// It runs the function ITERATIONS times using std::chrono::high_resolution_clock,
-// averages the elapsed times (measured in microseconds, then converted to ms),
-// and returns a pair: {result, averageElapsedTime in ms}.
+// One probe call checks the timeout and warms up; CycleTimer then grows a
+// batch on warm calls until the clock reads are negligible next to it
+// (at least 20 us per timed batch). The function is timed
+// in ITERATIONS batches between two serialized TSC reads (or steady_clock
+// reads where no invariant TSC exists), the read overhead is subtracted,
+// and the per-call times are averaged. Returns {result, averageElapsedTime in ms}.
 // A volatile temporary variable is used to prevent compiler optimization.
 template <typename Func>
 static std::pair<int, double> runWithTimeout(const Func& func, const std::vector<int>& inputArray, int expectedOutput, double timeoutSec) {
-    double totalTime = 0.0;
-    int result = 0;
+    const CycleTimer& timer = CycleTimer::instance();
+    const double timeoutNs = timeoutSec * 1e9;
+
+    // Probe call: doubles as warm-up and as the estimate for the batch size.
+    std::uint64_t probeStart = timer.start();
+    volatile int probe_result = func(inputArray);  // Prevent compiler optimization.
+    std::uint64_t probeStop = timer.stop();
+    int result = probe_result;
+    double probeTicks = timer.netTicks(probeStart, probeStop);
+    if (timer.toNs(probeTicks) >= timeoutNs) {
+        std::cerr << "Timeout occurred after " << timeoutSec << " seconds in iteration 1" << std::endl;
+        return { -1, timer.toNs(probeTicks) / 1e6 };
+    }
+    // The probe was cold and so overestimates the call cost: start from its
+    // estimate, then grow the batch on warm calls until a timed batch is
+    // long enough.
+    std::size_t batch = timer.calibrateBatch([&func, &inputArray]() {
+        volatile int calibrate_result = func(inputArray);  // Prevent compiler optimization.
+        (void)calibrate_result;
+    }, timer.batchSizeFor(inputArray.size(), probeTicks));
+
+    double totalTicks = 0.0;
     for (int i = 0; i < ITERATIONS; i++) {
-        auto start = std::chrono::high_resolution_clock::now();
-        volatile int tmp_result = func(inputArray);  // Prevent compiler optimization.
-        result = tmp_result;
-        auto end = std::chrono::high_resolution_clock::now();
-        // Measure in microseconds, then convert to milliseconds.
-        double elapsedTime = std::chrono::duration<double, std::micro>(end - start).count() / 1000.0;
-        totalTime += elapsedTime;
+        std::uint64_t start = timer.start();
+        for (std::size_t j = 0; j < batch; j++) {
+            volatile int tmp_result = func(inputArray);  // Prevent compiler optimization.
+            result = tmp_result;
+        }
+        std::uint64_t end = timer.stop();
+        double callTicks = timer.netTicks(start, end) / batch;
+        totalTicks += callTicks;
         // If any iteration exceeds the timeout, report a timeout immediately.
-        if (elapsedTime >= timeoutSec * 1000.0) {
+        if (timer.toNs(callTicks) >= timeoutNs) {
             std::cerr << "Timeout occurred after " << timeoutSec << " seconds in iteration " << i + 1 << std::endl;
-            return { -1, totalTime / (i + 1) };
+            return { -1, timer.toNs(totalTicks / (i + 1)) / 1e6 };
         }
     }
-    double avgTime = totalTime / ITERATIONS;
+    double avgTicks = totalTicks / ITERATIONS;
+    double avgTime = timer.toNs(avgTicks) / 1e6;
+    // Callers print the returned times with their own formatting, so leave
+    // std::cout's flags and precision as we found them.
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize oldPrecision = std::cout.precision();
     // If the average is very low, output in microseconds.
     if (avgTime < 1.0) {
         std::cout << std::fixed << std::setprecision(7)
-                  << "Average elapsed time: " << avgTime * 1000.0 << " us" << std::endl;
+                  << "Average elapsed time: " << avgTime * 1000.0 << " us";
     } else {
         std::cout << std::fixed << std::setprecision(6)
-                  << "Average elapsed time: " << avgTime << " ms" << std::endl;
+                  << "Average elapsed time: " << avgTime << " ms";
+    }
+    // Per-element cost, so inputs of different lengths can be compared.
+    double elements = static_cast<double>(std::max<std::size_t>(inputArray.size(), 1));
+    std::cout << std::setprecision(3) << " (batch " << batch << ", "
+              << timer.toNs(avgTicks) / elements << " ns/elem, ";
+    if (timer.usesTsc()) {
+        std::cout << avgTicks / elements << " cycles/elem)" << std::endl;
+    } else {
+        std::cout << "cycles/elem n/a: steady_clock)" << std::endl;
     }
+    std::cout.flags(oldFlags);
+    std::cout.precision(oldPrecision);
     return { result, avgTime };
 }
 
@@ -76,8 +148,9 @@ std::vector<TestResult> MultiSolutionTestRunner::runTests(
     const std::function<int(const std::vector<int>&)>& dynamicFunc,
     const std::function<int(const std::vector<int>&)>& greedyFunc) {
     
+    TraceSpan runSpan("runTests");
     std::vector<TestResult> results;
-    std::ifstream infile(filename);
+    StreamingLineReader infile(filename);
     if (!infile.is_open()) {
         std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
         return results;
@@ -96,10 +169,10 @@ std::vector<TestResult> MultiSolutionTestRunner::runTests(
     int dynamicPassed = 0;
     int greedyPassed = 0;
     
-    while (std::getline(infile, inputLine)) {
+    while (readLine(infile, inputLine)) {
         if (inputLine.empty())
             continue;
-        if (!std::getline(infile, expectedLine)) {
+        if (!readLine(infile, expectedLine)) {
             std::cerr << "Error: Expected output missing for test case " << testCase << std::endl;
             break;
         }
@@ -114,44 +187,65 @@ std::vector<TestResult> MultiSolutionTestRunner::runTests(
         tr.expected = expectedOutput;
         
         // Run naive solution with timeout.
-        auto naiveResultPair = runWithTimeout(naiveFunc, inputArray, expectedOutput, 3.0);
+        std::pair<int, double> naiveResultPair;
+        {
+            TraceSpan span("solve:Naive", "size", tr.inputSize);
+            naiveResultPair = runWithTimeout(naiveFunc, inputArray, expectedOutput, 3.0);
+        }
         tr.naiveTime = naiveResultPair.second;
-        if (naiveResultPair.first == -1) {
-            tr.naiveResult = -1;
-            tr.naivePassed = false;
-        } else {
-            tr.naiveResult = naiveResultPair.first;
-            tr.naivePassed = (naiveResultPair.first == expectedOutput);
-            if (tr.naivePassed)
-                naivePassed++;
+        {
+            TraceSpan span("compare");
+            if (naiveResultPair.first == -1) {
+                tr.naiveResult = -1;
+                tr.naivePassed = false;
+            } else {
+                tr.naiveResult = naiveResultPair.first;
+                tr.naivePassed = (naiveResultPair.first == expectedOutput);
+                if (tr.naivePassed)
+                    naivePassed++;
+            }
         }
         elapsedTimesNaive_.push_back(tr.naiveTime);
         
         // Run dynamic solution with timeout.
-        auto dynamicResultPair = runWithTimeout(dynamicFunc, inputArray, expectedOutput, 3.0);
+        std::pair<int, double> dynamicResultPair;
+        {
+            TraceSpan span("solve:Dynamic", "size", tr.inputSize);
+            dynamicResultPair = runWithTimeout(dynamicFunc, inputArray, expectedOutput, 3.0);
+        }
         tr.dynamicTime = dynamicResultPair.second;
-        if (dynamicResultPair.first == -1) {
-            tr.dynamicResult = -1;
-            tr.dynamicPassed = false;
-        } else {
-            tr.dynamicResult = dynamicResultPair.first;
-            tr.dynamicPassed = (dynamicResultPair.first == expectedOutput);
-            if (tr.dynamicPassed)
-                dynamicPassed++;
+        {
+            TraceSpan span("compare");
+            if (dynamicResultPair.first == -1) {
+                tr.dynamicResult = -1;
+                tr.dynamicPassed = false;
+            } else {
+                tr.dynamicResult = dynamicResultPair.first;
+                tr.dynamicPassed = (dynamicResultPair.first == expectedOutput);
+                if (tr.dynamicPassed)
+                    dynamicPassed++;
+            }
         }
         elapsedTimesDynamic_.push_back(tr.dynamicTime);
         
         // Run greedy solution with timeout.
-        auto greedyResultPair = runWithTimeout(greedyFunc, inputArray, expectedOutput, 3.0);
+        std::pair<int, double> greedyResultPair;
+        {
+            TraceSpan span("solve:Greedy", "size", tr.inputSize);
+            greedyResultPair = runWithTimeout(greedyFunc, inputArray, expectedOutput, 3.0);
+        }
         tr.greedyTime = greedyResultPair.second;
-        if (greedyResultPair.first == -1) {
-            tr.greedyResult = -1;
-            tr.greedyPassed = false;
-        } else {
-            tr.greedyResult = greedyResultPair.first;
-            tr.greedyPassed = (greedyResultPair.first == expectedOutput);
-            if (tr.greedyPassed)
-                greedyPassed++;
+        {
+            TraceSpan span("compare");
+            if (greedyResultPair.first == -1) {
+                tr.greedyResult = -1;
+                tr.greedyPassed = false;
+            } else {
+                tr.greedyResult = greedyResultPair.first;
+                tr.greedyPassed = (greedyResultPair.first == expectedOutput);
+                if (tr.greedyPassed)
+                    greedyPassed++;
+            }
         }
         elapsedTimesGreedy_.push_back(tr.greedyTime);
         
@@ -159,6 +253,8 @@ std::vector<TestResult> MultiSolutionTestRunner::runTests(
         testCase++;
     }
     
+    bool incomplete = reportInputFailure(infile, filename, totalTests);
+    infile.printInputSummary();
     infile.close();
     
     double naivePercent = (totalTests > 0) ? (naivePassed * 100.0 / totalTests) : 0.0;
@@ -166,7 +262,8 @@ std::vector<TestResult> MultiSolutionTestRunner::runTests(
     double greedyPercent = (totalTests > 0) ? (greedyPassed * 100.0 / totalTests) : 0.0;
     
     std::cout << "\nTest Summary (All Solutions):" << std::endl;
-    std::cout << "Total test cases: " << totalTests << std::endl;
+    std::cout << "Total test cases: " << totalTests
+              << (incomplete ? " (INCOMPLETE: input error)" : "") << std::endl;
     std::cout << "Naive passed: " << naivePassed << " (" << naivePercent << "%)" << std::endl;
     std::cout << "Dynamic passed: " << dynamicPassed << " (" << dynamicPercent << "%)" << std::endl;
     std::cout << "Greedy passed: " << greedyPassed << " (" << greedyPercent << "%)" << std::endl;
@@ -179,8 +276,9 @@ std::vector<TestResult> MultiSolutionTestRunner::runSingleTests(
     const std::function<int(const std::vector<int>&)>& solutionFunc,
     const std::string& label) {
     
+    TraceSpan runSpan("runSingleTests");
     std::vector<TestResult> results;
-    std::ifstream infile(filename);
+    StreamingLineReader infile(filename);
     if (!infile.is_open()) {
         std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
         return results;
@@ -192,10 +290,10 @@ std::vector<TestResult> MultiSolutionTestRunner::runSingleTests(
     int totalTests = 0;
     int passedCount = 0;
     
-    while (std::getline(infile, inputLine)) {
+    while (readLine(infile, inputLine)) {
         if (inputLine.empty())
             continue;
-        if (!std::getline(infile, expectedLine)) {
+        if (!readLine(infile, expectedLine)) {
             std::cerr << "Error: Expected output missing for test case " << testCase << std::endl;
             break;
         }
@@ -209,40 +307,47 @@ std::vector<TestResult> MultiSolutionTestRunner::runSingleTests(
         tr.inputSize = static_cast<int>(inputArray.size());
         tr.expected = expectedOutput;
         
-        auto resultPair = runWithTimeout(solutionFunc, inputArray, expectedOutput, 5.0);
+        std::pair<int, double> resultPair;
+        {
+            TraceSpan span(solveSpanName(label), "size", tr.inputSize);
+            resultPair = runWithTimeout(solutionFunc, inputArray, expectedOutput, 5.0);
+        }
         
-        if (label == "Naive") {
-            tr.naiveTime = resultPair.second;
-            if (resultPair.first == -1) {
-                tr.naiveResult = -1;
-                tr.naivePassed = false;
-            } else {
-                tr.naiveResult = resultPair.first;
-                tr.naivePassed = (resultPair.first == expectedOutput);
-                if (tr.naivePassed)
-                    passedCount++;
-            }
-        } else if (label == "Dynamic") {
-            tr.dynamicTime = resultPair.second;
-            if (resultPair.first == -1) {
-                tr.dynamicResult = -1;
-                tr.dynamicPassed = false;
-            } else {
-                tr.dynamicResult = resultPair.first;
-                tr.dynamicPassed = (resultPair.first == expectedOutput);
-                if (tr.dynamicPassed)
-                    passedCount++;
-            }
-        } else if (label == "Greedy") {
-            tr.greedyTime = resultPair.second;
-            if (resultPair.first == -1) {
-                tr.greedyResult = -1;
-                tr.greedyPassed = false;
-            } else {
-                tr.greedyResult = resultPair.first;
-                tr.greedyPassed = (resultPair.first == expectedOutput);
-                if (tr.greedyPassed)
-                    passedCount++;
+        {
+            TraceSpan span("compare");
+            if (label == "Naive") {
+                tr.naiveTime = resultPair.second;
+                if (resultPair.first == -1) {
+                    tr.naiveResult = -1;
+                    tr.naivePassed = false;
+                } else {
+                    tr.naiveResult = resultPair.first;
+                    tr.naivePassed = (resultPair.first == expectedOutput);
+                    if (tr.naivePassed)
+                        passedCount++;
+                }
+            } else if (label == "Dynamic") {
+                tr.dynamicTime = resultPair.second;
+                if (resultPair.first == -1) {
+                    tr.dynamicResult = -1;
+                    tr.dynamicPassed = false;
+                } else {
+                    tr.dynamicResult = resultPair.first;
+                    tr.dynamicPassed = (resultPair.first == expectedOutput);
+                    if (tr.dynamicPassed)
+                        passedCount++;
+                }
+            } else if (label == "Greedy") {
+                tr.greedyTime = resultPair.second;
+                if (resultPair.first == -1) {
+                    tr.greedyResult = -1;
+                    tr.greedyPassed = false;
+                } else {
+                    tr.greedyResult = resultPair.first;
+                    tr.greedyPassed = (resultPair.first == expectedOutput);
+                    if (tr.greedyPassed)
+                        passedCount++;
+                }
             }
         }
         
@@ -250,11 +355,14 @@ std::vector<TestResult> MultiSolutionTestRunner::runSingleTests(
         testCase++;
     }
     
+    bool incomplete = reportInputFailure(infile, filename, totalTests);
+    infile.printInputSummary();
     infile.close();
     
     double percentPassed = (totalTests > 0) ? (passedCount * 100.0 / totalTests) : 0.0;
     std::cout << "\nTest Summary (" << label << "):" << std::endl;
-    std::cout << "Total test cases: " << totalTests << std::endl;
+    std::cout << "Total test cases: " << totalTests
+              << (incomplete ? " (INCOMPLETE: input error)" : "") << std::endl;
     std::cout << "Passed: " << passedCount << " (" << percentPassed << "%)" << std::endl;
     
     return results;
@@ -271,3 +379,54 @@ const std::vector<double>& MultiSolutionTestRunner::getElapsedTimesDynamic() con
 const std::vector<double>& MultiSolutionTestRunner::getElapsedTimesGreedy() const {
     return elapsedTimesGreedy_;
 }
+
+bool MultiSolutionTestRunner::measureInputThroughput(const std::string& filename) {
+    TraceSpan runSpan("measureInputThroughput");
+    auto start = std::chrono::steady_clock::now();
+    StreamingLineReader infile(filename);
+    if (!infile.is_open()) {
+        std::cerr << "Error: Could not open file '" << filename << "'." << std::endl;
+        return false;
+    }
+
+    std::string inputLine;
+    std::string expectedLine;
+    int totalTests = 0;
+    long long totalHeights = 0;
+    long long checksum = 0;
+    while (readLine(infile, inputLine)) {
+        if (inputLine.empty())
+            continue;
+        if (!readLine(infile, expectedLine)) {
+            std::cerr << "Error: Expected output missing for test case " << totalTests + 1 << std::endl;
+            break;
+        }
+        std::vector<int> inputArray = parseArrayLine(inputLine);
+        checksum += parseExpectedLine(expectedLine);
+        totalHeights += static_cast<long long>(inputArray.size());
+        totalTests++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    volatile long long sink = checksum;  // Prevent compiler optimization.
+    (void)sink;
+    // A rate over part of the file would look like a (fast) complete read.
+    if (reportInputFailure(infile, filename, totalTests))
+        return false;
+
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize oldPrecision = std::cout.precision();
+    std::cout << "\nInput Throughput (" << infile.format() << "):" << std::endl;
+    std::cout << "Test cases: " << totalTests << ", heights: " << totalHeights << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << "Read and parsed " << infile.fileBytes() / 1e6 << " MB on disk ("
+              << infile.dataBytes() / 1e6 << " MB of text) in " << seconds * 1000.0 << " ms" << std::endl;
+    if (seconds > 0.0) {
+        std::cout << std::setprecision(1)
+                  << "Effective input rate: " << infile.fileBytes() / 1e6 / seconds << " MB/s on disk, "
+                  << infile.dataBytes() / 1e6 / seconds << " MB/s of text" << std::endl;
+    }
+    std::cout.flags(oldFlags);
+    std::cout.precision(oldPrecision);
+    infile.printInputSummary();
+    return true;
+}
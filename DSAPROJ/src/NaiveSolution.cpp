@@ -2,22 +2,26 @@
 #include "NaiveSolution.hpp"
 using namespace std;
 int NaiveSolution::findWater(const std::vector<int>& vec) const{
-    int size = vec.size();
+    return static_cast<int>(findWater(vec.data(), vec.size()));
+}
+
+long long NaiveSolution::findWater(const int* vec, std::size_t n) const{
+    std::size_t size = n;
     if(size<3){
         return 0;
     }
-    int totalWater = 0;
+    long long totalWater = 0;
     
-    for(int i = 0;i<size-1;i++){
+    for(std::size_t i = 0;i<size-1;i++){
         int leftMax = 0;
         int rightMax = 0;
 
         //left bar
-        for(int j=0;j <= i;j++){
+        for(std::size_t j=0;j <= i;j++){
             leftMax = max(leftMax,vec[j]);
         }
         //right bar
-        for(int k=i;k <= size-1;k++){
+        for(std::size_t k=i;k <= size-1;k++){
             rightMax = max(rightMax,vec[k]);
         }
         //calculate water at i
@@ -0,0 +1,52 @@
+#include "PerfCounter.hpp"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+
+PerfCounter PerfCounter::dtlbReadMisses() {
+    return PerfCounter(PERF_TYPE_HW_CACHE,
+                       PERF_COUNT_HW_CACHE_DTLB |
+                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+PerfCounter::PerfCounter(unsigned type, unsigned long long config) : fd_(-1) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    // User space only, so the counter works with perf_event_paranoid <= 2.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+PerfCounter::~PerfCounter() {
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+PerfCounter::PerfCounter(PerfCounter&& other) noexcept : fd_(other.fd_) {
+    other.fd_ = -1;
+}
+
+void PerfCounter::start() {
+    if (fd_ < 0)
+        return;
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+long long PerfCounter::stop() {
+    if (fd_ < 0)
+        return -1;
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+        return -1;
+    return count;
+}
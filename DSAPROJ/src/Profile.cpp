@@ -0,0 +1,18 @@
+#include "Profile.hpp"
+#include <random>
+
+std::vector<int> makeRandomWalkProfile(std::size_t size, int maxStep, unsigned seed) {
+    std::vector<int> heights(size);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> step(-maxStep, maxStep);
+    int h = 500;
+    for (std::size_t i = 0; i < size; i++) {
+        h += step(rng);
+        if (h < 0)
+            h = 0;
+        if (h > 1000)
+            h = 1000;
+        heights[i] = h;
+    }
+    return heights;
+}
@@ -0,0 +1,86 @@
+#include "SlidingWindowBenchmark.hpp"
+#include "GreedySolution.hpp"
+#include "Profile.hpp"
+#include "SlidingWindowWater.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Every window is streamed for at least this many samples past its fill.
+static const std::size_t MIN_MEASURED_SAMPLES = 1000000;
+// Budget of heights re-scanned by the recompute baseline per window size.
+static const double BASELINE_ELEMENTS = 2e7;
+// Windows up to this size are cross-checked against GreedySolution.
+static const std::size_t CHECKED_WINDOW = 1000;
+
+bool SlidingWindowBenchmark::run() {
+    GreedySolution greedy;
+    bool allAgree = true;
+
+    std::cout << std::left
+              << std::setw(12) << "Window"
+              << std::setw(14) << "Samples"
+              << std::setw(18) << "Samples/s"
+              << std::setw(14) << "ns/sample"
+              << std::setw(22) << "Recompute samples/s"
+              << std::setw(10) << "Speedup"
+              << std::endl;
+    std::cout << std::string(12+14+18+14+22+10, '-') << std::endl;
+
+    for (std::size_t window = 100; window <= 10000000; window *= 10) {
+        // Fill the window once, then measure a stream of new samples.
+        std::size_t measured = std::max(MIN_MEASURED_SAMPLES, window);
+        std::vector<int> stream = makeRandomWalkProfile(window + measured, 8, static_cast<unsigned>(window));
+
+        SlidingWindowWater monitor(window);
+        for (std::size_t i = 0; i < window; i++)
+            monitor.push(stream[i]);
+
+        long long checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = window; i < stream.size(); i++) {
+            monitor.push(stream[i]);
+            checksum += monitor.water();
+        }
+        auto end = std::chrono::steady_clock::now();
+        volatile long long sink = checksum;  // Prevent compiler optimization.
+        (void)sink;
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double rate = measured / seconds;
+
+        // Baseline: recompute the whole window with GreedySolution per sample.
+        std::size_t baselineSamples = std::max<std::size_t>(
+            3, std::min<std::size_t>(measured, static_cast<std::size_t>(BASELINE_ELEMENTS / window)));
+        start = std::chrono::steady_clock::now();
+        for (std::size_t s = 0; s < baselineSamples; s++) {
+            const int* first = stream.data() + measured - baselineSamples + s + 1;
+            volatile long long water = greedy.findWater(first, window);
+            (void)water;
+        }
+        end = std::chrono::steady_clock::now();
+        double baselineRate = baselineSamples / std::chrono::duration<double>(end - start).count();
+
+        // The monitor now holds the last `window` samples of the stream.
+        if (window <= CHECKED_WINDOW) {
+            long long expected = greedy.findWater(stream.data() + measured, window);
+            if (monitor.water() != expected) {
+                std::cerr << "Error: window " << window << " reports " << monitor.water()
+                          << " but GreedySolution gives " << expected << std::endl;
+                allAgree = false;
+            }
+        }
+
+        std::cout << std::left
+                  << std::setw(12) << window
+                  << std::setw(14) << measured
+                  << std::setw(18) << std::fixed << std::setprecision(0) << rate
+                  << std::setw(14) << std::fixed << std::setprecision(1) << 1e9 / rate
+                  << std::setw(22) << std::fixed << std::setprecision(0) << baselineRate
+                  << std::setw(10) << std::fixed << std::setprecision(1) << rate / baselineRate
+                  << std::endl;
+    }
+    return allAgree;
+}
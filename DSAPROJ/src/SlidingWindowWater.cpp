@@ -0,0 +1,134 @@
+#include "SlidingWindowWater.hpp"
+#include <algorithm>
+#include <limits>
+
+// Stands in for the maximum of an empty segment.
+static const long long NO_MAX = std::numeric_limits<long long>::min();
+
+SlidingWindowWater::SlidingWindowWater(std::size_t window)
+    : window_(std::max<std::size_t>(window, 1)), suffixSum_(0), frontStart_(0), heightSum_(0) {}
+
+void SlidingWindowWater::push(int height) {
+    if (size() == window_)
+        popFront();
+
+    std::size_t index = back_.size();
+    back_.push_back(height);
+    heightSum_ += height;
+
+    // A new prefix maximum starts a new step of the staircase.
+    if (steps_.empty() || height > steps_.back().value) {
+        long long before = 0;
+        if (!steps_.empty()) {
+            const Step& last = steps_.back();
+            before = last.before + static_cast<long long>(last.value) * (index - last.start);
+        }
+        steps_.push_back({height, index, before});
+    }
+
+    // Every earlier suffix maximum not above the new height now equals it.
+    std::size_t count = 1;
+    while (!suffix_.empty() && suffix_.back().value <= height) {
+        suffixSum_ -= static_cast<long long>(suffix_.back().value) * suffix_.back().count;
+        count += suffix_.back().count;
+        suffix_.pop_back();
+    }
+    suffix_.push_back({height, count});
+    suffixSum_ += static_cast<long long>(height) * count;
+}
+
+void SlidingWindowWater::popFront() {
+    if (frontStart_ == front_.size())
+        rebuildFront();
+    heightSum_ -= front_[frontStart_];
+    frontStart_++;
+}
+
+void SlidingWindowWater::rebuildFront() {
+    front_.swap(back_);
+    back_.clear();
+    steps_.clear();
+    suffix_.clear();
+    suffixSum_ = 0;
+    frontStart_ = 0;
+
+    std::size_t n = front_.size();
+    prefixFrom_.assign(n, 0);
+    lastMax_.assign(n, 0);
+    frontSuffix_.assign(n, 0);
+    frontSuffixSums_.assign(n + 1, 0);
+
+    // Right to left: nextGreater holds indices with strictly increasing heights,
+    // so its top is the first height to the right that exceeds front_[i].
+    std::vector<std::size_t> nextGreater;
+    for (std::size_t i = n; i-- > 0;) {
+        int h = front_[i];
+        if (i + 1 == n || h > frontSuffix_[i + 1]) {
+            frontSuffix_[i] = h;
+            lastMax_[i] = i;
+        } else {
+            frontSuffix_[i] = frontSuffix_[i + 1];
+            lastMax_[i] = lastMax_[i + 1];
+        }
+
+        while (!nextGreater.empty() && front_[nextGreater.back()] <= h)
+            nextGreater.pop_back();
+        std::size_t next = nextGreater.empty() ? n : nextGreater.back();
+        prefixFrom_[i] = static_cast<long long>(h) * (next - i) + (next < n ? prefixFrom_[next] : 0);
+        nextGreater.push_back(i);
+    }
+    for (std::size_t i = 0; i < n; i++)
+        frontSuffixSums_[i + 1] = frontSuffixSums_[i] + frontSuffix_[i];
+}
+
+long long SlidingWindowWater::backPrefixSumClamped(long long floor) const {
+    // Steps at or below the floor are replaced by the floor itself.
+    auto above = std::upper_bound(steps_.begin(), steps_.end(), floor,
+                                  [](long long f, const Step& s) { return f < s.value; });
+    if (above == steps_.end())
+        return floor * static_cast<long long>(back_.size());
+    const Step& last = steps_.back();
+    long long total = last.before + static_cast<long long>(last.value) * (back_.size() - last.start);
+    long long clamped = (above->start > 0) ? floor * static_cast<long long>(above->start) : 0;
+    return clamped + (total - above->before);
+}
+
+long long SlidingWindowWater::water() const {
+    bool hasFront = frontStart_ < front_.size();
+    bool hasBack = !back_.empty();
+    if (!hasFront && !hasBack)
+        return 0;
+
+    std::size_t j = frontStart_;
+    long long frontMax = hasFront ? frontSuffix_[j] : NO_MAX;
+    long long backMax = hasBack ? steps_.back().value : NO_MAX;
+    long long total;
+
+    if (hasBack && backMax >= frontMax) {
+        // The window maximum is in the back segment. Front heights hold their
+        // prefix maxima; back heights up to the back's last maximum hold
+        // max(frontMax, back prefix max), the rest their suffix maxima.
+        long long front = hasFront ? prefixFrom_[j] : 0;
+        std::size_t bottom = suffix_.front().count;  // positions up to the last maximum
+        std::size_t tail = back_.size() - bottom;
+        long long backLeft = backPrefixSumClamped(frontMax) - backMax * static_cast<long long>(tail);
+        long long backRight = suffixSum_ - backMax * static_cast<long long>(bottom);
+        total = front + backLeft + backRight;
+    } else {
+        // The window maximum is in the front segment, at its last position m.
+        // Heights up to m hold their prefix maxima; front heights after m
+        // hold max(front suffix max, backMax); back heights their suffix maxima.
+        std::size_t k = front_.size() - 1;
+        std::size_t m = lastMax_[j];
+        long long left = prefixFrom_[j] - frontMax * static_cast<long long>(k - m);
+        auto first = frontSuffix_.begin() + (m + 1);
+        auto last = frontSuffix_.begin() + (k + 1);
+        std::size_t p = std::partition_point(first, last,
+                                             [backMax](int v) { return v >= backMax; }) - frontSuffix_.begin();
+        long long right = frontSuffixSums_[p] - frontSuffixSums_[m + 1];
+        if (p <= k)
+            right += backMax * static_cast<long long>(k + 1 - p);
+        total = left + right + suffixSum_;
+    }
+    return total - heightSum_;
+}
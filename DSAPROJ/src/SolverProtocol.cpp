@@ -0,0 +1,37 @@
+#include "SolverProtocol.hpp"
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace SolverProtocol {
+
+bool readFully(int fd, void* buffer, std::size_t size) {
+    char* p = static_cast<char*>(buffer);
+    while (size > 0) {
+        ssize_t n = ::read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const void* buffer, std::size_t size) {
+    const char* p = static_cast<const char*>(buffer);
+    while (size > 0) {
+        // MSG_NOSIGNAL: a client that hung up must not kill the server with SIGPIPE.
+        ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace SolverProtocol
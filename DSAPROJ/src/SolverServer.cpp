@@ -0,0 +1,366 @@
+#include "SolverServer.hpp"
+#include "DynamicSolution.hpp"
+#include "GreedySolution.hpp"
+#include "NaiveSolution.hpp"
+#include "SolverProtocol.hpp"
+#include "Trace.hpp"
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+// How often the accept loop wakes up to check for stop().
+static const int ACCEPT_POLL_MS = 200;
+// Buffers with more capacity than this are freed instead of pooled.
+static const std::size_t MAX_POOLED_HEIGHTS = 1 << 20;
+// Payloads are read (and the height buffer grown) this many heights at a
+// time, so a header alone never makes the server allocate its full count.
+static const std::size_t PAYLOAD_CHUNK_HEIGHTS = 1 << 16;
+// Readers wait before queueing past either limit; a request always gets in
+// when the queue is empty, so one at kMaxHeights is never refused.
+static const std::size_t MAX_QUEUED_REQUESTS = 4096;
+static const std::size_t MAX_QUEUED_HEIGHTS = 1 << 24;
+
+// Helper function: largest count accepted for a solve request to `solver`.
+static std::uint32_t maxHeightsFor(std::uint32_t solver) {
+    return solver == SolverProtocol::kNaive ? SolverProtocol::kMaxNaiveHeights
+                                            : SolverProtocol::kMaxHeights;
+}
+
+// Helper function: reads and drops `count` heights of a rejected request.
+static bool skipPayload(int fd, std::uint32_t count) {
+    int scratch[1024];
+    std::size_t left = count;
+    while (left > 0) {
+        std::size_t n = std::min<std::size_t>(left, sizeof(scratch) / sizeof(int));
+        if (!SolverProtocol::readFully(fd, scratch, n * sizeof(int)))
+            return false;
+        left -= n;
+    }
+    return true;
+}
+
+// Helper function: reads `count` heights into `heights`, growing it chunk by
+// chunk as the data actually arrives.
+static bool readPayload(int fd, std::uint32_t count, std::vector<int>& heights) {
+    heights.clear();
+    std::size_t have = 0;
+    while (have < count) {
+        std::size_t n = std::min<std::size_t>(count - have, PAYLOAD_CHUNK_HEIGHTS);
+        heights.resize(have + n);
+        if (!SolverProtocol::readFully(fd, heights.data() + have, n * sizeof(int)))
+            return false;
+        have += n;
+    }
+    return true;
+}
+
+struct SolverServer::Connection {
+    int fd;
+    std::mutex writeMutex;  // workers answer out of order, one write at a time
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { ::close(fd); }
+};
+
+struct SolverServer::Request {
+    std::shared_ptr<Connection> connection;
+    std::uint64_t id;
+    std::uint32_t solver;
+    std::vector<int> heights;
+    std::chrono::steady_clock::time_point received;
+};
+
+SolverServer::SolverServer(const std::string& socketPath, unsigned workers, std::size_t maxBatch)
+    : socketPath_(socketPath), workerCount_(workers < 1 ? 1 : workers),
+      maxBatch_(maxBatch < 1 ? 1 : maxBatch), stopping_(false), listenFd_(-1),
+      queuedHeights_(0), batches_(0) {}
+
+SolverServer::~SolverServer() {
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        ::unlink(socketPath_.c_str());
+    }
+}
+
+void SolverServer::stop() {
+    stopping_.store(true);
+}
+
+bool SolverServer::run() {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: Socket path '" << socketPath_ << "' is too long." << std::endl;
+        return false;
+    }
+    std::strncpy(addr.sun_path, socketPath_.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        std::cerr << "Error: Could not create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ::unlink(socketPath_.c_str());
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listenFd_, SOMAXCONN) < 0) {
+        std::cerr << "Error: Could not listen on '" << socketPath_ << "': "
+                  << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    startTime_ = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < workerCount_; i++)
+        workers_.emplace_back(&SolverServer::workerLoop, this);
+    std::cout << "Serving on " << socketPath_ << " with " << workerCount_
+              << " workers, batches of up to " << maxBatch_ << std::endl;
+
+    while (!stopping_.load()) {
+        pollfd pfd = {listenFd_, POLLIN, 0};
+        if (::poll(&pfd, 1, ACCEPT_POLL_MS) <= 0)
+            continue;
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+        reapReaders();
+        auto connection = std::make_shared<Connection>(fd);
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connections_.push_back(connection);
+        readers_.push_back({std::thread(&SolverServer::readLoop, this, connection, done), done});
+    }
+
+    // Unblock readers, then let workers drain what is already queued.
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (auto& weak : connections_) {
+            if (auto connection = weak.lock())
+                ::shutdown(connection->fd, SHUT_RDWR);
+        }
+    }
+    {
+        // Taking the lock orders this wake-up after any reader's check of stopping_.
+        std::lock_guard<std::mutex> lock(queueMutex_);
+    }
+    queueSpace_.notify_all();
+    for (auto& reader : readers_)
+        reader.thread.join();
+    queueReady_.notify_all();
+    for (auto& worker : workers_)
+        worker.join();
+    return true;
+}
+
+// Joins reader threads of closed connections and forgets their connections.
+void SolverServer::reapReaders() {
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    for (auto it = readers_.begin(); it != readers_.end();) {
+        if (it->done->load()) {
+            it->thread.join();
+            it = readers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        if (it->expired())
+            it = connections_.erase(it);
+        else
+            ++it;
+    }
+}
+
+void SolverServer::readLoop(std::shared_ptr<Connection> connection,
+                            std::shared_ptr<std::atomic<bool>> done) {
+    SolverProtocol::RequestHeader header;
+    while (SolverProtocol::readFully(connection->fd, &header, sizeof(header))) {
+        if (header.magic != SolverProtocol::kMagic) {
+            std::cerr << "Error: Malformed request; closing connection." << std::endl;
+            break;
+        }
+        if (header.type == SolverProtocol::kStats && header.count == 0) {
+            answerStats(connection, header.id);
+            continue;
+        }
+        if (header.type != SolverProtocol::kSolve || header.count > maxHeightsFor(header.solver)) {
+            // Skip the payload so the next header is read from the right place.
+            if (!skipPayload(connection->fd, header.count))
+                break;
+            answerError(connection, header.id, SolverProtocol::kBadRequest);
+            continue;
+        }
+
+        std::unique_ptr<Request> request(new Request);
+        request->connection = connection;
+        request->id = header.id;
+        request->solver = header.solver;
+        request->heights = takeBuffer();
+        try {
+            if (!readPayload(connection->fd, header.count, request->heights))
+                break;
+        } catch (const std::bad_alloc&) {
+            std::cerr << "Error: Out of memory reading a request; closing connection." << std::endl;
+            break;
+        }
+        request->received = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            std::size_t count = request->heights.size();
+            queueSpace_.wait(lock, [this, count]() {
+                return queue_.empty() || stopping_.load() ||
+                       (queue_.size() < MAX_QUEUED_REQUESTS &&
+                        queuedHeights_ + count <= MAX_QUEUED_HEIGHTS);
+            });
+            if (stopping_.load())
+                break;
+            queuedHeights_ += count;
+            queue_.push_back(std::move(request));
+        }
+        queueReady_.notify_one();
+    }
+    // Stop further reads; pending responses still hold the connection open.
+    ::shutdown(connection->fd, SHUT_RD);
+    done->store(true);
+}
+
+void SolverServer::workerLoop() {
+    NaiveSolution naive;
+    DynamicSolution dynamic;
+    GreedySolution greedy;
+    DynamicScratch dynamicScratch;  // warm max arrays, reused across requests
+    std::vector<std::unique_ptr<Request>> batch;
+    batch.reserve(maxBatch_);
+
+    while (true) {
+        bool workLeft;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueReady_.wait(lock, [this]() { return !queue_.empty() || stopping_.load(); });
+            if (queue_.empty())
+                return;  // stopping and nothing left to answer
+            // Take this worker's share of what piled up, up to maxBatch, so
+            // a backlog is spread over the pool instead of one worker.
+            std::size_t share = (queue_.size() + workerCount_ - 1) / workerCount_;
+            std::size_t take = share < maxBatch_ ? share : maxBatch_;
+            while (batch.size() < take) {
+                queuedHeights_ -= queue_.front()->heights.size();
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+            workLeft = !queue_.empty();
+        }
+        queueSpace_.notify_all();
+        if (workLeft)
+            queueReady_.notify_one();  // hand the rest to another worker
+        batches_++;
+
+        TraceSpan span("serveBatch", "requests", static_cast<long long>(batch.size()));
+        for (auto& request : batch) {
+            SolverProtocol::SolveResponse response;
+            response.magic = SolverProtocol::kMagic;
+            response.status = SolverProtocol::kOk;
+            response.id = request->id;
+            response.water = 0;
+            switch (request->solver) {
+                case SolverProtocol::kNaive:
+                    response.water = naive.findWater(request->heights.data(), request->heights.size());
+                    break;
+                case SolverProtocol::kDynamic:
+                    response.water = dynamic.findWater(request->heights.data(), request->heights.size(),
+                                                       dynamicScratch);
+                    // Like the height pool, do not pin scratch for outsized requests.
+                    if (dynamicScratch.leftMax.size() > MAX_POOLED_HEIGHTS)
+                        dynamicScratch = DynamicScratch();
+                    break;
+                case SolverProtocol::kGreedy:
+                    response.water = greedy.findWater(request->heights.data(), request->heights.size());
+                    break;
+                default:
+                    response.status = SolverProtocol::kBadSolver;
+            }
+            {
+                std::lock_guard<std::mutex> lock(request->connection->writeMutex);
+                SolverProtocol::writeFully(request->connection->fd, &response, sizeof(response));
+            }
+            auto done = std::chrono::steady_clock::now();
+            latency_.record(std::chrono::duration<double, std::micro>(done - request->received).count());
+            returnBuffer(std::move(request->heights));
+        }
+        batch.clear();
+    }
+}
+
+void SolverServer::answerError(const std::shared_ptr<Connection>& connection, std::uint64_t id,
+                               std::uint32_t status) {
+    SolverProtocol::SolveResponse response;
+    response.magic = SolverProtocol::kMagic;
+    response.status = status;
+    response.id = id;
+    response.water = 0;
+    std::lock_guard<std::mutex> lock(connection->writeMutex);
+    SolverProtocol::writeFully(connection->fd, &response, sizeof(response));
+}
+
+void SolverServer::answerStats(const std::shared_ptr<Connection>& connection, std::uint64_t id) {
+    std::vector<double> p = latency_.percentiles({50.0, 90.0, 99.0, 99.9});
+    double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+
+    SolverProtocol::StatsResponse stats;
+    stats.magic = SolverProtocol::kMagic;
+    stats.status = SolverProtocol::kOk;
+    stats.id = id;
+    stats.requests = latency_.count();
+    stats.batches = batches_.load();
+    stats.uptimeSec = uptime;
+    stats.requestsPerSec = uptime > 0.0 ? stats.requests / uptime : 0.0;
+    stats.p50Us = p[0];
+    stats.p90Us = p[1];
+    stats.p99Us = p[2];
+    stats.p999Us = p[3];
+
+    std::lock_guard<std::mutex> lock(connection->writeMutex);
+    SolverProtocol::writeFully(connection->fd, &stats, sizeof(stats));
+}
+
+std::vector<int> SolverServer::takeBuffer() {
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    if (bufferPool_.empty())
+        return std::vector<int>();
+    std::vector<int> buffer = std::move(bufferPool_.back());
+    bufferPool_.pop_back();
+    return buffer;
+}
+
+void SolverServer::returnBuffer(std::vector<int>&& buffer) {
+    if (buffer.capacity() > MAX_POOLED_HEIGHTS)
+        return;
+    buffer.clear();
+    std::lock_guard<std::mutex> lock(poolMutex_);
+    bufferPool_.push_back(std::move(buffer));
+}
+
+void SolverServer::printStats() const {
+    std::vector<double> p = latency_.percentiles({50.0, 90.0, 99.0, 99.9});
+    double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime_).count();
+    std::size_t requests = latency_.count();
+    std::uint64_t batches = batches_.load();
+
+    std::cout << "\nServer Summary:" << std::endl;
+    std::cout << "Requests served: " << requests << " in " << batches << " batches";
+    if (batches > 0)
+        std::cout << " (avg " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(requests) / batches << " per batch)";
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Requests/second: " << (uptime > 0.0 ? requests / uptime : 0.0) << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Latency (us): p50 " << p[0] << ", p90 " << p[1]
+              << ", p99 " << p[2] << ", p99.9 " << p[3] << std::endl;
+}
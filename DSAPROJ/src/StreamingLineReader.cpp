@@ -0,0 +1,302 @@
+#include "StreamingLineReader.hpp"
+#include "Trace.hpp"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <zlib.h>
+#ifdef DSAPROJ_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+static const unsigned char GZIP_MAGIC[2] = {0x1f, 0x8b};
+static const unsigned char ZSTD_MAGIC[4] = {0x28, 0xb5, 0x2f, 0xfd};
+
+StreamingLineReader::StreamingLineReader(const std::string& filename)
+    : file_(nullptr), format_("plain"), blocks_(kBlocksInFlight), finished_(false),
+      stopping_(false), current_(nullptr), pos_(0), waitSeconds_(0.0), failed_(false),
+      fileBytes_(0), dataBytes_(0), producerSeconds_(0.0) {
+    file_ = std::fopen(filename.c_str(), "rb");
+    if (!file_)
+        return;
+
+    // Detect the format from the magic bytes, then rewind.
+    unsigned char magic[4] = {0, 0, 0, 0};
+    std::size_t got = std::fread(magic, 1, sizeof(magic), file_);
+    std::rewind(file_);
+    if (got >= 2 && std::memcmp(magic, GZIP_MAGIC, sizeof(GZIP_MAGIC)) == 0) {
+        format_ = "gzip";
+    } else if (got >= 4 && std::memcmp(magic, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0) {
+        format_ = "zstd";
+#ifndef DSAPROJ_WITH_ZSTD
+        std::cerr << "Error: '" << filename << "' is zstd-compressed but this build has no "
+                  << "zstd support (rebuild with 'make ZSTD=1')." << std::endl;
+        std::fclose(file_);
+        file_ = nullptr;
+        return;
+#endif
+    }
+
+    for (auto& block : blocks_) {
+        block.data.resize(kBlockBytes);
+        free_.push_back(&block);
+    }
+    producer_ = std::thread(&StreamingLineReader::produce, this);
+}
+
+StreamingLineReader::~StreamingLineReader() {
+    close();
+}
+
+void StreamingLineReader::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    if (producer_.joinable())
+        producer_.join();
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool StreamingLineReader::getline(std::string& line) {
+    line.clear();
+    bool readAny = false;
+    while (true) {
+        if (!current_ || pos_ == current_->size) {
+            if (!nextBlock())
+                return readAny;
+            continue;
+        }
+        const char* begin = current_->data.data() + pos_;
+        std::size_t left = current_->size - pos_;
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', left));
+        if (newline) {
+            line.append(begin, newline);
+            pos_ += static_cast<std::size_t>(newline - begin) + 1;
+            return true;
+        }
+        // The line continues in the next block.
+        line.append(begin, left);
+        pos_ = current_->size;
+        readAny = true;
+    }
+}
+
+bool StreamingLineReader::nextBlock() {
+    TraceSpan span("waitBlock");
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (current_) {
+        free_.push_back(current_);
+        current_ = nullptr;
+        changed_.notify_all();
+    }
+    changed_.wait(lock, [this]() { return !full_.empty() || finished_ || stopping_; });
+    if (full_.empty() || stopping_)
+        return false;
+    current_ = full_.front();
+    full_.pop_front();
+    pos_ = 0;
+    return true;
+}
+
+StreamingLineReader::Block* StreamingLineReader::acquireFree() {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]() { return !free_.empty() || stopping_; });
+    waitSeconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (stopping_)
+        return nullptr;
+    Block* block = free_.front();
+    free_.pop_front();
+    block->size = 0;
+    return block;
+}
+
+void StreamingLineReader::publish(Block* block) {
+    dataBytes_ += block->size;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (block->size > 0)
+        full_.push_back(block);
+    else
+        free_.push_back(block);
+    changed_.notify_all();
+}
+
+void StreamingLineReader::produce() {
+    auto start = std::chrono::steady_clock::now();
+    bool ok;
+    if (std::strcmp(format_, "gzip") == 0)
+        ok = produceGzip();
+    else if (std::strcmp(format_, "zstd") == 0)
+        ok = produceZstd();
+    else
+        ok = producePlain();
+    failed_ = !ok;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    producerSeconds_ = elapsed - waitSeconds_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+    changed_.notify_all();
+}
+
+bool StreamingLineReader::producePlain() {
+    while (true) {
+        Block* block = acquireFree();
+        if (!block)
+            return true;
+        TraceSpan span("readBlock");
+        std::size_t got = std::fread(block->data.data(), 1, kBlockBytes, file_);
+        block->size = got;
+        fileBytes_ += got;
+        publish(block);
+        if (got < kBlockBytes)
+            break;
+    }
+    if (std::ferror(file_)) {
+        std::cerr << "Error: Read failed while streaming test file." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool StreamingLineReader::produceGzip() {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // 15 + 32: maximum window, accept both gzip and zlib headers.
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        std::cerr << "Error: Could not initialise gzip decoder." << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> input(kBlockBytes);
+    Block* block = acquireFree();
+    bool ok = true;
+    bool inMember = false;       // inside a gzip member that has not ended yet
+    bool pendingOutput = false;  // the decoder may still hold output for us
+
+    while (block) {
+        TraceSpan span("inflateBlock");
+        stream.next_out = reinterpret_cast<Bytef*>(block->data.data() + block->size);
+        stream.avail_out = static_cast<uInt>(kBlockBytes - block->size);
+
+        if (stream.avail_in == 0 && !pendingOutput) {
+            std::size_t got = std::fread(input.data(), 1, input.size(), file_);
+            fileBytes_ += got;
+            if (got == 0) {
+                if (std::ferror(file_) || inMember) {
+                    std::cerr << "Error: Compressed test file is truncated or unreadable." << std::endl;
+                    ok = false;
+                }
+                break;
+            }
+            stream.next_in = input.data();
+            stream.avail_in = static_cast<uInt>(got);
+        }
+
+        int ret = inflate(&stream, Z_NO_FLUSH);
+        block->size = kBlockBytes - stream.avail_out;
+        if (ret == Z_STREAM_END) {
+            // Concatenated gzip files are a sequence of members.
+            inflateReset(&stream);
+            inMember = false;
+        } else if (ret == Z_OK) {
+            inMember = true;
+        } else if (ret != Z_BUF_ERROR) {
+            // Z_BUF_ERROR only means no progress was possible: leave inMember
+            // alone so a reset stream with no input left is not "truncated".
+            std::cerr << "Error: gzip data error: " << (stream.msg ? stream.msg : "unknown") << std::endl;
+            ok = false;
+            break;
+        }
+
+        // A member that ended exactly at the end of the block has nothing
+        // left to flush, so only a mid-member full block needs another call.
+        pendingOutput = (ret != Z_STREAM_END && stream.avail_out == 0);
+        if (stream.avail_out == 0) {
+            publish(block);
+            block = acquireFree();
+        }
+    }
+    if (block)
+        publish(block);
+    inflateEnd(&stream);
+    return ok;
+}
+
+bool StreamingLineReader::produceZstd() {
+#ifdef DSAPROJ_WITH_ZSTD
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream))) {
+        std::cerr << "Error: Could not initialise zstd decoder." << std::endl;
+        ZSTD_freeDStream(stream);
+        return false;
+    }
+    std::vector<char> input(ZSTD_DStreamInSize());
+    ZSTD_inBuffer in = {input.data(), 0, 0};
+    Block* block = acquireFree();
+    bool ok = true;
+    std::size_t pending = 0;  // 0 once the last frame is complete
+    bool pendingOutput = false;
+
+    while (block) {
+        TraceSpan span("zstdBlock");
+        if (in.pos == in.size && !pendingOutput) {
+            std::size_t got = std::fread(input.data(), 1, input.size(), file_);
+            fileBytes_ += got;
+            if (got == 0) {
+                if (std::ferror(file_) || pending != 0) {
+                    std::cerr << "Error: Compressed test file is truncated or unreadable." << std::endl;
+                    ok = false;
+                }
+                break;
+            }
+            in.size = got;
+            in.pos = 0;
+        }
+
+        ZSTD_outBuffer out = {block->data.data(), kBlockBytes, block->size};
+        pending = ZSTD_decompressStream(stream, &out, &in);
+        if (ZSTD_isError(pending)) {
+            std::cerr << "Error: zstd data error: " << ZSTD_getErrorName(pending) << std::endl;
+            ok = false;
+            break;
+        }
+        block->size = out.pos;
+
+        // As for gzip: a frame that ended exactly at the end of the block
+        // has nothing left to flush.
+        pendingOutput = (pending != 0 && out.pos == out.size);
+        if (out.pos == out.size) {
+            publish(block);
+            block = acquireFree();
+        }
+    }
+    if (block)
+        publish(block);
+    ZSTD_freeDStream(stream);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+void StreamingLineReader::printInputSummary() const {
+    double seconds = producerSeconds();
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize oldPrecision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(3)
+              << "Input (" << format_ << "): " << fileBytes() / 1e6 << " MB on disk, "
+              << dataBytes() / 1e6 << " MB of text, decoder busy "
+              << seconds * 1000.0 << " ms";
+    if (seconds > 0.0) {
+        std::cout << std::setprecision(1) << " (" << fileBytes() / 1e6 / seconds << " MB/s on disk, "
+                  << dataBytes() / 1e6 / seconds << " MB/s of text)";
+    }
+    std::cout << std::endl;
+    std::cout.flags(oldFlags);
+    std::cout.precision(oldPrecision);
+}
@@ -0,0 +1,123 @@
+#include "Trace.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Tracer::enabled_(false);
+
+namespace {
+
+// Ring buffer owned by a single recording thread.
+struct ThreadRing {
+    int threadId;
+    std::size_t next = 0;      // slot the next span is written to
+    std::size_t count = 0;     // number of valid slots (<= kRingCapacity)
+    std::vector<TraceEvent> events;
+};
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Rings are shared with the registry so spans survive their thread exiting.
+std::vector<std::shared_ptr<ThreadRing>>& registry() {
+    static std::vector<std::shared_ptr<ThreadRing>> rings;
+    return rings;
+}
+
+const std::chrono::steady_clock::time_point& epoch() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+ThreadRing& localRing() {
+    thread_local std::shared_ptr<ThreadRing> ring;
+    if (!ring) {
+        ring = std::make_shared<ThreadRing>();
+        ring->events.resize(Tracer::kRingCapacity);
+        std::lock_guard<std::mutex> lock(registryMutex());
+        ring->threadId = static_cast<int>(registry().size()) + 1;
+        registry().push_back(ring);
+    }
+    return *ring;
+}
+
+// Writes a string literal as a JSON string, escaping quotes and backslashes.
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\')
+            out << '\\';
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Tracer::setEnabled(bool enabled) {
+    // Pin the epoch before the first span so timestamps start near zero.
+    epoch();
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+std::int64_t Tracer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch()).count();
+}
+
+void Tracer::record(const char* name, const char* argName, long long argValue,
+                    std::int64_t startNs, std::int64_t endNs) {
+    ThreadRing& ring = localRing();
+    TraceEvent& ev = ring.events[ring.next];
+    ev.name = name;
+    ev.argName = argName;
+    ev.argValue = argValue;
+    ev.startNs = startNs;
+    ev.durationNs = endNs - startNs;
+    ring.next = (ring.next + 1) % kRingCapacity;
+    if (ring.count < kRingCapacity)
+        ring.count++;
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open trace file '" << filename << "'." << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& ring : registry()) {
+        // Name each thread so the viewer shows readable track labels.
+        out << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+            << ring->threadId << ",\"args\":{\"name\":\"thread " << ring->threadId << "\"}}";
+        first = false;
+
+        // Walk the ring from oldest to newest span.
+        std::size_t oldest = (ring->next + kRingCapacity - ring->count) % kRingCapacity;
+        for (std::size_t i = 0; i < ring->count; i++) {
+            const TraceEvent& ev = ring->events[(oldest + i) % kRingCapacity];
+            out << ",\n{\"ph\":\"X\",\"cat\":\"dsaproj\",\"pid\":1,\"tid\":" << ring->threadId
+                << ",\"name\":";
+            writeJsonString(out, ev.name);
+            // Trace-event timestamps are in microseconds.
+            out << ",\"ts\":" << ev.startNs / 1000 << '.' << ev.startNs % 1000 / 100
+                << ",\"dur\":" << ev.durationNs / 1000 << '.' << ev.durationNs % 1000 / 100;
+            if (ev.argName) {
+                out << ",\"args\":{";
+                writeJsonString(out, ev.argName);
+                out << ':' << ev.argValue << '}';
+            }
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
@@ -1,9 +1,65 @@
 #include "Menu.hpp"
+#include "SolverServer.hpp"
+#include "Trace.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
-int main() {
-    // Assume your test CSV file is named "testCases.csv"
-    Menu menu("testCases.csv");
-    menu.run();
-    return 0;
+// Server stopped by SIGINT/SIGTERM in --serve mode.
+static SolverServer* activeServer = nullptr;
+
+static void handleStopSignal(int) {
+    if (activeServer)
+        activeServer->stop();
+}
+
+// Runs the solver daemon: Project --serve <socket> [workers] [maxBatch]
+static int runServer(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " --serve <socket> [workers] [maxBatch]" << std::endl;
+        return 1;
+    }
+    unsigned workers = std::thread::hardware_concurrency();
+    if (argc > 3)
+        workers = static_cast<unsigned>(std::atoi(argv[3]));
+    std::size_t maxBatch = (argc > 4) ? static_cast<std::size_t>(std::atoi(argv[4])) : 64;
+
+    SolverServer server(argv[2], workers, maxBatch);
+    activeServer = &server;
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+    bool ok = server.run();
+    activeServer = nullptr;
+    if (ok)
+        server.printStats();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Set DSAPROJ_TRACE=<file.json> to record a Chrome trace-event timeline
+    // of the test runs; the file is written when the menu or server exits.
+    const char* traceFile = std::getenv("DSAPROJ_TRACE");
+    if (traceFile && *traceFile) {
+        Tracer::setEnabled(true);
+    }
+
+    int status = 0;
+    if (argc > 1 && std::strcmp(argv[1], "--serve") == 0) {
+        status = runServer(argc, argv);
+    } else {
+        // Test cases default to "testCases.csv"; a path argument may name
+        // another file, plain or gzip/zstd-compressed (e.g. testCases.csv.gz).
+        Menu menu(argc > 1 ? argv[1] : "testCases.csv");
+        menu.run();
+    }
+
+    if (traceFile && *traceFile) {
+        Tracer::setEnabled(false);
+        if (Tracer::writeChromeTrace(traceFile)) {
+            std::cout << "Trace written to " << traceFile << std::endl;
+        }
+    }
+    return status;
 }
@@ -0,0 +1,194 @@
+// Load generator for the solver daemon (Project --serve).
+//
+// Usage: LoadGen <socket> [connections] [requests] [heights] [solver] [pipeline]
+//   connections  concurrent client connections (default 4)
+//   requests     solve requests sent per connection (default 10000)
+//   heights      heights per request (default 10)
+//   solver       naive, dynamic or greedy (default greedy)
+//   pipeline     requests kept in flight per connection (default 16)
+//
+// Prints client-side throughput and latency percentiles, then the server's
+// own statistics fetched with a stats request.
+
+#include "GreedySolution.hpp"
+#include "LatencyStats.hpp"
+#include "SolverProtocol.hpp"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Helper function: connect to the daemon, or return -1.
+static int connectTo(const std::string& path) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Helper function: map a solver name to its protocol id.
+static bool parseSolver(const std::string& name, std::uint32_t& id) {
+    if (name == "naive")
+        id = SolverProtocol::kNaive;
+    else if (name == "dynamic")
+        id = SolverProtocol::kDynamic;
+    else if (name == "greedy")
+        id = SolverProtocol::kGreedy;
+    else
+        return false;
+    return true;
+}
+
+// Sends `requests` solve requests over one connection, keeping `pipeline` in flight.
+static bool runConnection(const std::string& path, int seed, int requests, int heightsPerRequest,
+                          std::uint32_t solver, int pipeline, LatencyStats& latency,
+                          std::atomic<int>& mismatches) {
+    int fd = connectTo(path);
+    if (fd < 0) {
+        std::cerr << "Error: Could not connect to '" << path << "'." << std::endl;
+        return false;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> height(0, 100);
+    std::vector<int> heights(heightsPerRequest);
+    for (auto& h : heights)
+        h = height(rng);
+    GreedySolution greedy;
+    const std::int64_t expected = greedy.findWater(heights.data(), heights.size());
+
+    SolverProtocol::RequestHeader header;
+    header.magic = SolverProtocol::kMagic;
+    header.type = SolverProtocol::kSolve;
+    header.solver = solver;
+    header.count = static_cast<std::uint32_t>(heightsPerRequest);
+
+    std::vector<std::chrono::steady_clock::time_point> sentAt(requests);
+    int sent = 0;
+    bool ok = true;
+    auto send = [&]() {
+        header.id = static_cast<std::uint64_t>(sent);
+        sentAt[sent] = std::chrono::steady_clock::now();
+        sent++;
+        return SolverProtocol::writeFully(fd, &header, sizeof(header)) &&
+               SolverProtocol::writeFully(fd, heights.data(), heights.size() * sizeof(int));
+    };
+
+    while (sent < requests && sent < pipeline && ok)
+        ok = send();
+    for (int received = 0; received < requests && ok; received++) {
+        SolverProtocol::SolveResponse response;
+        if (!SolverProtocol::readFully(fd, &response, sizeof(response)) ||
+            response.magic != SolverProtocol::kMagic || response.id >= static_cast<std::uint64_t>(requests)) {
+            std::cerr << "Error: Bad or missing response from server." << std::endl;
+            ok = false;
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        latency.record(std::chrono::duration<double, std::micro>(now - sentAt[response.id]).count());
+        if (response.status != SolverProtocol::kOk || response.water != expected)
+            mismatches++;
+        if (sent < requests)
+            ok = send();
+    }
+    ::close(fd);
+    return ok;
+}
+
+// Fetches and prints the server's own statistics.
+static void printServerStats(const std::string& path) {
+    int fd = connectTo(path);
+    if (fd < 0)
+        return;
+    SolverProtocol::RequestHeader header;
+    header.magic = SolverProtocol::kMagic;
+    header.type = SolverProtocol::kStats;
+    header.solver = 0;
+    header.count = 0;
+    header.id = 0;
+    SolverProtocol::StatsResponse stats;
+    if (SolverProtocol::writeFully(fd, &header, sizeof(header)) &&
+        SolverProtocol::readFully(fd, &stats, sizeof(stats))) {
+        std::cout << "\nServer Statistics:" << std::endl;
+        std::cout << "Requests served: " << stats.requests << " in " << stats.batches << " batches";
+        if (stats.batches > 0)
+            std::cout << " (avg " << std::fixed << std::setprecision(2)
+                      << static_cast<double>(stats.requests) / stats.batches << " per batch)";
+        std::cout << std::endl;
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Requests/second since start: " << stats.requestsPerSec << std::endl;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Latency (us): p50 " << stats.p50Us << ", p90 " << stats.p90Us
+                  << ", p99 " << stats.p99Us << ", p99.9 " << stats.p999Us << std::endl;
+    }
+    ::close(fd);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <socket> [connections] [requests] [heights] [solver] [pipeline]" << std::endl;
+        return 1;
+    }
+    std::string path = argv[1];
+    int connections = (argc > 2) ? std::atoi(argv[2]) : 4;
+    int requests = (argc > 3) ? std::atoi(argv[3]) : 10000;
+    int heightsPerRequest = (argc > 4) ? std::atoi(argv[4]) : 10;
+    std::uint32_t solver = SolverProtocol::kGreedy;
+    if (argc > 5 && !parseSolver(argv[5], solver)) {
+        std::cerr << "Error: Unknown solver '" << argv[5] << "' (use naive, dynamic or greedy)." << std::endl;
+        return 1;
+    }
+    int pipeline = (argc > 6) ? std::atoi(argv[6]) : 16;
+    if (connections < 1 || requests < 1 || heightsPerRequest < 0 || pipeline < 1) {
+        std::cerr << "Error: Counts must be positive." << std::endl;
+        return 1;
+    }
+
+    LatencyStats latency;
+    std::atomic<int> mismatches(0);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < connections; c++) {
+        clients.emplace_back([&, c]() {
+            if (!runConnection(path, c + 1, requests, heightsPerRequest, solver, pipeline,
+                               latency, mismatches))
+                failures++;
+        });
+    }
+    for (auto& client : clients)
+        client.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> p = latency.percentiles({50.0, 90.0, 99.0, 99.9});
+    std::cout << "Client Summary:" << std::endl;
+    std::cout << "Connections: " << connections << ", requests: " << latency.count()
+              << ", heights per request: " << heightsPerRequest << ", pipeline: " << pipeline << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Requests/second: " << latency.count() / seconds << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Latency (us): p50 " << p[0] << ", p90 " << p[1]
+              << ", p99 " << p[2] << ", p99.9 " << p[3] << std::endl;
+    std::cout << "Wrong answers: " << mismatches.load() << std::endl;
+
+    printServerStats(path);
+    return (failures.load() == 0 && mismatches.load() == 0) ? 0 : 1;
+}